@@ -24,7 +24,10 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 #include <wx/datetime.h>
@@ -287,6 +290,95 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
+void S3D_CACHE::Preload( const std::vector<wxString>& aModelFiles )
+{
+    std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+    std::vector<std::pair<wxString, S3D_CACHE_ENTRY*>> entries;
+
+    for( const wxString& modelFile : aModelFiles )
+    {
+        wxString full3Dpath = m_FNResolver->ResolvePath( modelFile );
+
+        if( full3Dpath.empty() || m_CacheMap.count( full3Dpath ) )
+            continue;
+
+        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
+        m_CacheList.push_back( ep );
+        m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >( full3Dpath, ep ) );
+        entries.emplace_back( full3Dpath, ep );
+    }
+
+    if( entries.empty() )
+        return;
+
+    bool useCacheFiles = !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache;
+
+    // Entries which could not be hashed are left empty to prevent further attempts at loading
+    // the file, as in checkCache()
+    std::vector<char>   needsPlugin( entries.size(), false );
+    std::atomic<size_t> nextEntry( 0 );
+    std::atomic<size_t> threadsFinished( 0 );
+
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+            entries.size() );
+
+    // Hash the files and read the cache files in parallel
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        std::thread t = std::thread( [&]()
+        {
+            for( size_t entryIdx = nextEntry.fetch_add( 1 );
+                        entryIdx < entries.size();
+                        entryIdx = nextEntry.fetch_add( 1 ) )
+            {
+                const wxString&  fileName = entries[entryIdx].first;
+                S3D_CACHE_ENTRY* ep = entries[entryIdx].second;
+                unsigned char    sha1sum[20];
+
+                ep->modTime = wxFileName( fileName ).GetModificationTime();
+
+                if( !getSHA1( fileName, sha1sum ) || m_CacheDir.empty() )
+                    continue;
+
+                ep->SetSHA1( sha1sum );
+
+                wxString cachename = m_CacheDir + ep->GetCacheBaseName() + wxT( ".3dc" );
+
+                if( useCacheFiles && wxFileName::FileExists( cachename )
+                        && loadCacheData( ep ) )
+                {
+                    continue;
+                }
+
+                needsPlugin[entryIdx] = true;
+            }
+
+            threadsFinished++;
+        } );
+
+        t.detach();
+    }
+
+    while( threadsFinished < parallelThreadCount )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+    for( size_t ii = 0; ii < entries.size(); ++ii )
+    {
+        if( !needsPlugin[ii] )
+            continue;
+
+        S3D_CACHE_ENTRY* ep = entries[ii].second;
+
+        ep->sceneData = m_Plugins->Load3DModel( entries[ii].first, ep->pluginInfo );
+
+        if( useCacheFiles && nullptr != ep->sceneData )
+            saveCacheData( ep );
+    }
+}
+
+
 SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
 {
     if( aCachePtr )
@@ -34,6 +34,7 @@
 #include "kicad_string.h"
 #include <list>
 #include <map>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -96,6 +97,18 @@ public:
      */
     SCENEGRAPH* Load( const wxString& aModelFile );
 
+    /**
+     * Load the scene data of a set of models ahead of their use.
+     *
+     * The model files are hashed and the models found in the cache directory are read
+     * concurrently.  The other models are then loaded by the plugins from the calling thread,
+     * as the plugins are not thread safe.  Models which are already cached are left alone;
+     * they are checked for changes when loaded.
+     *
+     * @param aModelFiles is the list of partial or full paths to the models to be loaded.
+     */
+    void Preload( const std::vector<wxString>& aModelFiles );
+
     FILENAME_RESOLVER* GetResolver() noexcept;
 
     /**
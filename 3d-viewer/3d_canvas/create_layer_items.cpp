@@ -838,22 +838,22 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         {
             // found
             SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            polyLayer->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
 
             wxASSERT( m_layerHoleIdPolys.find( layer ) != m_layerHoleIdPolys.end() );
 
             polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            polyLayer->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
         }
     }
 
     // End Build Copper layers
 
     // This will make a union of all added contours
-    m_throughHoleOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_nonPlatedThroughHoleOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_throughHoleViaOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_throughHoleAnnularRingPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+    m_throughHoleOdPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+    m_nonPlatedThroughHoleOdPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+    m_throughHoleViaOdPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+    m_throughHoleAnnularRingPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
 
     // Build Tech layers
     // Based on:
@@ -29,6 +29,9 @@
 
 #include "bvh_pbrt.h"
 
+#include <algorithm>
+#include <limits>
+
 
 #define BVH_RANGED_TRAVERSAL
 //#define BVH_PARTITION_TRAVERSAL
@@ -44,22 +47,76 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                        unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+#ifdef BVH_RANGED_TRAVERSAL
+
+// Scale of the far distance of the box test, which absorbs its rounding errors
+static constexpr float BOX_FAR_SCALE = 1.0f + 4.0f * std::numeric_limits<float>::epsilon();
+
+
+/**
+ * Test which rays of a packet hit \a aBBox before their current hit.
+ *
+ * This is a slab test on the structure of arrays layout of the packet, which the compiler
+ * vectorizes.  It is conservative: rays running in the plane of a box face are reported as
+ * hits.
+ */
+static inline void getBoxHits( const RAYPACKET_SOA& aRays, const BBOX_3D& aBBox, bool* aHits )
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const SFVEC3F& bmin = aBBox.Min();
+    const SFVEC3F& bmax = aBBox.Max();
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        float tNear = -inf;
+        float tFar = inf;
+
+        for( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            const float t0 = ( bmin[axis] - aRays.m_origin[axis][i] ) * aRays.m_invDir[axis][i];
+            const float t1 = ( bmax[axis] - aRays.m_origin[axis][i] ) * aRays.m_invDir[axis][i];
+
+            // A NaN comes from a ray running in the plane of a face: ignore this axis
+            const bool  valid = ( t0 == t0 ) & ( t1 == t1 );
+            const float tMin = valid ? std::min( t0, t1 ) : -inf;
+            const float tMax = valid ? std::max( t0, t1 ) : inf;
+
+            tNear = std::max( tNear, tMin );
+            tFar = std::min( tFar, tMax );
+        }
+
+        aHits[i] = ( tNear <= tFar * BOX_FAR_SCALE ) & ( tFar >= 0.0f )
+                   & ( tNear < aRays.m_tHit[i] );
+    }
+}
+
+
+/**
+ * @return the first ray from \a ia which hits \a aBBox, or RAYPACKET_RAYS_PER_PACKET.
+ *
+ * \a aBoxHits is only filled if \a aBoxHitsValid is set to true.
+ */
+static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const RAYPACKET_SOA& aRays,
+                                        const BBOX_3D& aBBox, unsigned int ia, bool* aBoxHits,
+                                        bool& aBoxHitsValid )
 {
     float hitT;
 
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT )
-      && ( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit ) )
+    aBoxHitsValid = false;
+
+    // Coherent rays usually hit the same boxes: try the first alive ray alone
+    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT ) && ( hitT < aRays.m_tHit[ia] ) )
         return ia;
 
     if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
         return RAYPACKET_RAYS_PER_PACKET;
 
+    getBoxHits( aRays, aBBox, aBoxHits );
+    aBoxHitsValid = true;
+
     for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
     {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT )
-          && ( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit ) )
+        if( aBoxHits[i] )
             return i;
     }
 
@@ -67,17 +124,11 @@ static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_
 }
 
 
-#ifdef BVH_RANGED_TRAVERSAL
-
-static inline unsigned int getLastHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                       unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+static inline unsigned int getLastHit( const bool* aBoxHits, unsigned int ia )
 {
     for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
     {
-        float hitT;
-
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT )
-          && ( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit ) )
+        if( aBoxHits[ie] )
             return ie + 1;
     }
 
@@ -101,13 +152,21 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
 
+    RAYPACKET_SOA rays( aRayPacket );
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        rays.m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+
+    bool boxHits[RAYPACKET_RAYS_PER_PACKET];
+    bool boxHitsValid;
+
     unsigned int ia = 0;
 
     while( true )
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        ia = getFirstHit( aRayPacket, rays, curCell->bounds, ia, boxHits, boxHitsValid );
 
         if( ia < RAYPACKET_RAYS_PER_PACKET )
         {
@@ -121,8 +180,10 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket, curCell->bounds, ia,
-                                                    aHitInfoPacket );
+                if( !boxHitsValid )
+                    getBoxHits( rays, curCell->bounds, boxHits );
+
+                const unsigned int ie = getLastHit( boxHits, ia );
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
@@ -130,15 +191,19 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
 
                     if( aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
                     {
+                        const uint64_t hits = obj->IntersectPacket( aRayPacket, rays, ia, ie,
+                                                                    aHitInfoPacket );
+
+                        if( !hits )
+                            continue;
+
+                        anyHit = true;
+
                         for( unsigned int i = ia; i < ie; ++i )
                         {
-                            const bool hit = obj->Intersect( aRayPacket.m_ray[i],
-                                                             aHitInfoPacket[i].m_HitInfo );
-
-                            if( hit )
+                            if( hits & ( uint64_t( 1 ) << i ) )
                             {
-                                anyHit |= hit;
-                                aHitInfoPacket[i].m_hitresult |= hit;
+                                aHitInfoPacket[i].m_hitresult = true;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
                             }
                         }
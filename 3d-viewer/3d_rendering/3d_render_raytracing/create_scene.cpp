@@ -1279,6 +1279,26 @@ void RENDER_3D_RAYTRACE::addPadsAndVias()
 
 void RENDER_3D_RAYTRACE::loadModels( CONTAINER_3D& aDstContainer, bool aSkipMaterialInformation )
 {
+    // Let the cache load all the models at once, so it can read them concurrently
+    std::vector<wxString> modelFiles;
+
+    for( FOOTPRINT* fp : m_boardAdapter.GetBoard()->Footprints() )
+    {
+        if( !m_boardAdapter.IsFootprintShown( (FOOTPRINT_ATTR_T) fp->GetAttributes() ) )
+            continue;
+
+        for( const FP_3DMODEL& model : fp->Models() )
+        {
+            if( ( static_cast<float>( model.m_Opacity ) > FLT_EPSILON )
+              && ( model.m_Show && !model.m_Filename.empty() ) )
+            {
+                modelFiles.push_back( model.m_Filename );
+            }
+        }
+    }
+
+    m_boardAdapter.Get3dCacheManager()->Preload( modelFiles );
+
     // Go for all footprints
     for( FOOTPRINT* fp : m_boardAdapter.GetBoard()->Footprints() )
     {
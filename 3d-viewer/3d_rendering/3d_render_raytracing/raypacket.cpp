@@ -30,6 +30,7 @@
 #include "raypacket.h"
 #include "../3d_fastmath.h"
 #include <wx/debug.h>
+#include <limits>
 
 
 static void RAYPACKET_GenerateFrustum( FRUSTUM* m_Frustum, RAY* m_ray )
@@ -185,3 +186,21 @@ void RAYPACKET_InitRays_with2DDisplacement( const CAMERA& aCamera, const SFVEC2F
         }
     }
 }
+
+
+RAYPACKET_SOA::RAYPACKET_SOA( const RAYPACKET& aRayPacket )
+{
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const RAY& ray = aRayPacket.m_ray[i];
+
+        for( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            m_origin[axis][i] = ray.m_Origin[axis];
+            m_dir[axis][i] = ray.m_Dir[axis];
+            m_invDir[axis][i] = ray.m_InvDir[axis];
+        }
+
+        m_tHit[i] = std::numeric_limits<float>::infinity();
+    }
+}
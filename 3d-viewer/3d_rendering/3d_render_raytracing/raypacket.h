@@ -59,6 +59,22 @@ struct RAYPACKET
     RAY         m_ray[RAYPACKET_RAYS_PER_PACKET];
 };
 
+/**
+ * The rays of a packet stored as structure of arrays, with the current hit distance of each ray.
+ *
+ * The loops over the rays of a packet read contiguous floats from these arrays, so that the
+ * compiler can test several rays at once with vector instructions.
+ */
+struct RAYPACKET_SOA
+{
+    explicit RAYPACKET_SOA( const RAYPACKET& aRayPacket );
+
+    alignas( 32 ) float m_origin[3][RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_dir[3][RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_invDir[3][RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_tHit[RAYPACKET_RAYS_PER_PACKET];
+};
+
 void RAYPACKET_InitRays( const CAMERA& aCamera, const SFVEC2F& aWindowsPosition, RAY* aRayPck );
 
 void RAYPACKET_InitRays_with2DDisplacement( const CAMERA& aCamera, const SFVEC2F& aWindowsPosition,
@@ -70,6 +70,7 @@ RENDER_3D_RAYTRACE::RENDER_3D_RAYTRACE( BOARD_ADAPTER& aAdapter, CAMERA& aCamera
     m_isPreview = false;
     m_renderState = RT_RENDER_STATE_MAX; // Set to an initial invalid state
     m_renderStartTime = 0;
+    m_tracingEndTime = 0;
     m_blockRenderProgressCount = 0;
 }
 
@@ -128,6 +129,7 @@ void RENDER_3D_RAYTRACE::SetCurWindowSize( const wxSize& aSize )
 void RENDER_3D_RAYTRACE::restartRenderState()
 {
     m_renderStartTime = GetRunningMicroSecs();
+    m_tracingEndTime = m_renderStartTime;
 
     m_renderState = RT_RENDER_STATE_TRACING;
     m_blockRenderProgressCount = 0;
@@ -336,12 +338,22 @@ void RENDER_3D_RAYTRACE::render( GLubyte* ptrPBO, REPORTER* aStatusReporter )
         break;
     }
 
-    if( aStatusReporter && ( m_renderState == RT_RENDER_STATE_FINISH ) )
+    if( m_renderState == RT_RENDER_STATE_FINISH )
     {
         // Calculation time in seconds
-        const double elapsed_time = (double)( GetRunningMicroSecs() - m_renderStartTime ) / 1e6;
+        const unsigned long int endTime = GetRunningMicroSecs();
+        const double elapsed_time = (double)( endTime - m_renderStartTime ) / 1e6;
 
-        aStatusReporter->Report( wxString::Format( _( "Rendering time %.3f s" ), elapsed_time ) );
+        wxLogTrace( m_logTrace, wxT( "RENDER_3D_RAYTRACE::render tracing %.3f s, "
+                                     "post processing %.3f s" ),
+                    (double)( m_tracingEndTime - m_renderStartTime ) / 1e6,
+                    (double)( endTime - m_tracingEndTime ) / 1e6 );
+
+        if( aStatusReporter )
+        {
+            aStatusReporter->Report( wxString::Format( _( "Rendering time %.3f s" ),
+                                                       elapsed_time ) );
+        }
     }
 }
 
@@ -403,6 +415,8 @@ void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReport
     // or mark it as finished
     if( m_blockRenderProgressCount >= m_blockPositions.size() )
     {
+        m_tracingEndTime = GetRunningMicroSecs();
+
         if( m_boardAdapter.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
             m_renderState = RT_RENDER_STATE_POST_PROCESS_SHADE;
         else
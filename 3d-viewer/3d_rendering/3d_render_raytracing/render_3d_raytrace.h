@@ -156,6 +156,9 @@ private:
     /// Time that the render starts
     unsigned long int m_renderStartTime;
 
+    /// Time that the tracing of the render ended, and the post processing started
+    unsigned long int m_tracingEndTime;
+
     /// Save the number of blocks progress of the render
     size_t m_blockRenderProgressCount;
 
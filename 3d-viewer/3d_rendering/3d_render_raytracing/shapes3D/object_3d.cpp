@@ -48,6 +48,25 @@ OBJECT_3D::OBJECT_3D( OBJECT_3D_TYPE aObjType )
 }
 
 
+uint64_t OBJECT_3D::IntersectPacket( const RAYPACKET& aRayPacket, RAYPACKET_SOA& aRays,
+                                     unsigned int aFirst, unsigned int aLast,
+                                     HITINFO_PACKET* aHitInfoPacket ) const
+{
+    uint64_t hits = 0;
+
+    for( unsigned int i = aFirst; i < aLast; ++i )
+    {
+        if( Intersect( aRayPacket.m_ray[i], aHitInfoPacket[i].m_HitInfo ) )
+        {
+            hits |= uint64_t( 1 ) << i;
+            aRays.m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+        }
+    }
+
+    return hits;
+}
+
+
 /*
  * Lookup table for OBJECT_2D_TYPE printed names
  */
@@ -31,6 +31,7 @@
 
 #include "bbox_3d.h"
 #include "../material.h"
+#include <cstdint>
 
 class BOARD_ITEM;
 class HITINFOR;
@@ -47,6 +48,9 @@ enum class OBJECT_3D_TYPE
 };
 
 
+static_assert( RAYPACKET_RAYS_PER_PACKET <= 64, "the packet hit masks are 64 bit wide" );
+
+
 class OBJECT_3D
 {
 public:
@@ -89,6 +93,19 @@ public:
      */
     virtual bool IntersectP( const RAY& aRay, float aMaxDistance ) const = 0;
 
+    /**
+     * Intersect the rays \a aFirst to \a aLast (excluded) of a ray packet.
+     *
+     * The default implementation tests the rays one by one.
+     *
+     * @param aRays is the packet as structure of arrays, the hit distance of the rays which hit
+     *              the object is updated.
+     * @return the mask of the rays which hit the object, bit i standing for the ray i.
+     */
+    virtual uint64_t IntersectPacket( const RAYPACKET& aRayPacket, RAYPACKET_SOA& aRays,
+                                      unsigned int aFirst, unsigned int aLast,
+                                      HITINFO_PACKET* aHitInfoPacket ) const;
+
     const BBOX_3D& GetBBox() const { return m_bbox; }
 
     const SFVEC3F& GetCentroid() const { return m_centroid; }
@@ -253,6 +253,85 @@ bool TRIANGLE::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
 }
 
 
+uint64_t TRIANGLE::IntersectPacket( const RAYPACKET& aRayPacket, RAYPACKET_SOA& aRays,
+                                    unsigned int aFirst, unsigned int aLast,
+                                    HITINFO_PACKET* aHitInfoPacket ) const
+{
+    const unsigned int ku = s_modulo[m_k + 1];
+    const unsigned int kv = s_modulo[m_k + 2];
+
+    const float* Ok = aRays.m_origin[m_k];
+    const float* Ou = aRays.m_origin[ku];
+    const float* Ov = aRays.m_origin[kv];
+    const float* Dk = aRays.m_dir[m_k];
+    const float* Du = aRays.m_dir[ku];
+    const float* Dv = aRays.m_dir[kv];
+    const float* Dx = aRays.m_dir[0];
+    const float* Dy = aRays.m_dir[1];
+    const float* Dz = aRays.m_dir[2];
+
+    const float Au = m_vertex[0][ku];
+    const float Av = m_vertex[0][kv];
+
+    // Run the tests of Intersect() on all the rays at once, without branches, so that they are
+    // vectorized.  The comparisons are written as in Intersect() to give the same results.
+    bool  candidate[RAYPACKET_RAYS_PER_PACKET];
+    float hitT[RAYPACKET_RAYS_PER_PACKET];
+    float hitU[RAYPACKET_RAYS_PER_PACKET];
+    float hitV[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int i = aFirst; i < aLast; ++i )
+    {
+        const float lnd = 1.0f / ( Dk[i] + m_nu * Du[i] + m_nv * Dv[i] );
+        const float t = ( m_nd - Ok[i] - m_nu * Ou[i] - m_nv * Ov[i] ) * lnd;
+
+        const float hu = Ou[i] + t * Du[i] - Au;
+        const float hv = Ov[i] + t * Dv[i] - Av;
+        const float beta = hv * m_bnu + hu * m_bnv;
+        const float gamma = hu * m_cnu + hv * m_cnv;
+        const float facing = Dx[i] * m_n.x + Dy[i] * m_n.y + Dz[i] * m_n.z;
+
+        candidate[i] = ( aRays.m_tHit[i] > t ) & ( t > 0.0f ) & !( beta < 0.0f )
+                       & !( gamma < 0.0f ) & !( ( beta + gamma ) > 1.0f ) & !( facing > 0.0f );
+
+        hitT[i] = t;
+        hitU[i] = beta;
+        hitV[i] = gamma;
+    }
+
+    // Only the rays which hit compute the hit point, normal and material, from the distance
+    // and barycentric coordinates found above
+    uint64_t hits = 0;
+
+    for( unsigned int i = aFirst; i < aLast; ++i )
+    {
+        if( !candidate[i] )
+            continue;
+
+        const RAY&  ray = aRayPacket.m_ray[i];
+        HITINFO&    hitInfo = aHitInfoPacket[i].m_HitInfo;
+        const float u = hitU[i];
+        const float v = hitV[i];
+
+        hitInfo.m_tHit = hitT[i];
+        hitInfo.m_HitPoint = ray.at( hitT[i] );
+
+        // interpolate vertex normals with UVW using Gouraud's shading
+        hitInfo.m_HitNormal = glm::normalize( ( 1.0f - u - v ) * m_normal[0] + u * m_normal[1]
+                                              + v * m_normal[2] );
+
+        m_material->Generate( hitInfo.m_HitNormal, ray, hitInfo );
+
+        hitInfo.pHitObject = this;
+
+        hits |= uint64_t( 1 ) << i;
+        aRays.m_tHit[i] = hitT[i];
+    }
+
+    return hits;
+}
+
+
 bool TRIANGLE::IntersectP( const RAY& aRay, float aMaxDistance ) const
 {
     //!TODO: precalc this
@@ -63,6 +63,9 @@ public:
 
     bool Intersect( const RAY& aRay, HITINFO& aHitInfo ) const override;
     bool IntersectP(const RAY& aRay, float aMaxDistance ) const override;
+    uint64_t IntersectPacket( const RAYPACKET& aRayPacket, RAYPACKET_SOA& aRays,
+                              unsigned int aFirst, unsigned int aLast,
+                              HITINFO_PACKET* aHitInfoPacket ) const override;
     bool Intersects( const BBOX_3D& aBBox ) const override;
     SFVEC3F GetDiffuseColor( const HITINFO& aHitInfo ) const override;
 
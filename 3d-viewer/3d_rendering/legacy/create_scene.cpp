@@ -30,6 +30,8 @@
 #include <trigo.h>
 #include <project.h>
 #include <profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <atomic>
+#include <thread>
 
 
 void RENDER_3D_LEGACY::addObjectTriangles( const FILLED_CIRCLE_2D* aFilledCircle,
@@ -302,6 +304,36 @@ OPENGL_RENDER_LIST* RENDER_3D_LEGACY::generateLayerList( const BVH_CONTAINER_2D*
                                                          const SHAPE_POLY_SET* aPolyList,
                                                          PCB_LAYER_ID aLayerId,
                                                          const BVH_CONTAINER_2D* aThroughHoles )
+{
+    TRIANGLE_DISPLAY_LIST* layerTriangles = generateLayerTriangles( aContainer, aPolyList,
+                                                                    aLayerId, aThroughHoles );
+
+    if( layerTriangles == nullptr )
+        return nullptr;
+
+    return createLayerList( layerTriangles, aLayerId );
+}
+
+
+OPENGL_RENDER_LIST* RENDER_3D_LEGACY::createLayerList( TRIANGLE_DISPLAY_LIST* aLayerTriangles,
+                                                       PCB_LAYER_ID aLayerId )
+{
+    float layer_z_bot = 0.0f;
+    float layer_z_top = 0.0f;
+
+    getLayerZPos( aLayerId, layer_z_top, layer_z_bot );
+
+    // store in a list so it will be latter deleted
+    m_triangles.push_back( aLayerTriangles );
+
+    // Create display list
+    return new OPENGL_RENDER_LIST( *aLayerTriangles, m_circleTexture, layer_z_bot, layer_z_top );
+}
+
+
+TRIANGLE_DISPLAY_LIST* RENDER_3D_LEGACY::generateLayerTriangles(
+        const BVH_CONTAINER_2D* aContainer, const SHAPE_POLY_SET* aPolyList,
+        PCB_LAYER_ID aLayerId, const BVH_CONTAINER_2D* aThroughHoles )
 {
     if( aContainer == nullptr )
         return nullptr;
@@ -321,9 +353,6 @@ OPENGL_RENDER_LIST* RENDER_3D_LEGACY::generateLayerList( const BVH_CONTAINER_2D*
 
     TRIANGLE_DISPLAY_LIST* layerTriangles = new TRIANGLE_DISPLAY_LIST( nrTrianglesEstimation );
 
-    // store in a list so it will be latter deleted
-    m_triangles.push_back( layerTriangles );
-
     // Load the 2D (X,Y axis) component of shapes
     for( const OBJECT_2D* itemOnLayer : listObject2d )
     {
@@ -368,8 +397,7 @@ OPENGL_RENDER_LIST* RENDER_3D_LEGACY::generateLayerList( const BVH_CONTAINER_2D*
                                               m_boardAdapter.BiuTo3dUnits(), false, aThroughHoles );
     }
 
-    // Create display list
-    return new OPENGL_RENDER_LIST( *layerTriangles, m_circleTexture, layer_z_bot, layer_z_top );
+    return layerTriangles;
 }
 
 
@@ -548,63 +576,97 @@ void RENDER_3D_LEGACY::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
 
     const MAP_POLY& map_poly = m_boardAdapter.GetPolyMap();
 
+    std::vector<std::pair<PCB_LAYER_ID, const BVH_CONTAINER_2D*>> layers;
+
     for( const auto ii : m_boardAdapter.GetLayerMap() )
     {
-        const PCB_LAYER_ID layer_id = ii.first;
-
-        if( !m_boardAdapter.Is3dLayerEnabled( layer_id ) )
-            continue;
-
-        const BVH_CONTAINER_2D* container2d = ii.second;
+        if( m_boardAdapter.Is3dLayerEnabled( ii.first ) )
+            layers.emplace_back( ii.first, ii.second );
+    }
 
-        SHAPE_POLY_SET polyListSubtracted;
-        SHAPE_POLY_SET* aPolyList = nullptr;
+    // Triangulate the layers concurrently.  The display lists must be created from this
+    // thread, which owns the OpenGL context.
+    std::vector<TRIANGLE_DISPLAY_LIST*> layerTriangles( layers.size(), nullptr );
+    std::atomic<size_t>                 nextLayer( 0 );
+    std::atomic<size_t>                 threadsFinished( 0 );
 
-        // Load the vertical (Z axis) component of shapes
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+            layers.size() );
 
-        if( map_poly.find( layer_id ) != map_poly.end() )
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        std::thread t = std::thread( [&]()
         {
-            polyListSubtracted = *map_poly.at( layer_id );;
-
-            if( ( layer_id != B_Paste ) && ( layer_id != F_Paste ) &&
-                m_boardAdapter.GetFlag( FL_USE_REALISTIC_MODE ) )
+            for( size_t layerIdx = nextLayer.fetch_add( 1 );
+                        layerIdx < layers.size();
+                        layerIdx = nextLayer.fetch_add( 1 ) )
             {
-                polyListSubtracted.BooleanIntersection( m_boardAdapter.GetBoardPoly(),
-                                                        SHAPE_POLY_SET::PM_FAST );
+                const PCB_LAYER_ID      layer_id    = layers[layerIdx].first;
+                const BVH_CONTAINER_2D* container2d = layers[layerIdx].second;
 
-                if( ( layer_id != B_Mask ) && ( layer_id != F_Mask ) )
-                {
-                    polyListSubtracted.BooleanSubtract( m_boardAdapter.GetThroughHoleOdPolys(),
-                                                        SHAPE_POLY_SET::PM_FAST );
-                    polyListSubtracted.BooleanSubtract(
-                            m_boardAdapter.GetOuterNonPlatedThroughHolePoly(),
-                            SHAPE_POLY_SET::PM_FAST );
-                }
+                SHAPE_POLY_SET polyListSubtracted;
+                SHAPE_POLY_SET* polyList = nullptr;
+
+                // Load the vertical (Z axis) component of shapes
 
-                if( m_boardAdapter.GetFlag( FL_SUBTRACT_MASK_FROM_SILK ) )
+                if( map_poly.find( layer_id ) != map_poly.end() )
                 {
-                    if( layer_id == B_SilkS && map_poly.find( B_Mask ) != map_poly.end() )
-                    {
-                        polyListSubtracted.BooleanSubtract( *map_poly.at( B_Mask ),
-                                                            SHAPE_POLY_SET::PM_FAST );
-                    }
-                    else if( layer_id == F_SilkS && map_poly.find( F_Mask ) != map_poly.end() )
+                    polyListSubtracted = *map_poly.at( layer_id );
+
+                    if( ( layer_id != B_Paste ) && ( layer_id != F_Paste ) &&
+                        m_boardAdapter.GetFlag( FL_USE_REALISTIC_MODE ) )
                     {
-                        polyListSubtracted.BooleanSubtract( *map_poly.at( F_Mask ),
-                                                            SHAPE_POLY_SET::PM_FAST );
+                        polyListSubtracted.BooleanIntersection( m_boardAdapter.GetBoardPoly(),
+                                                                SHAPE_POLY_SET::PM_FAST );
+
+                        if( ( layer_id != B_Mask ) && ( layer_id != F_Mask ) )
+                        {
+                            polyListSubtracted.BooleanSubtract(
+                                    m_boardAdapter.GetThroughHoleOdPolys(),
+                                    SHAPE_POLY_SET::PM_FAST );
+                            polyListSubtracted.BooleanSubtract(
+                                    m_boardAdapter.GetOuterNonPlatedThroughHolePoly(),
+                                    SHAPE_POLY_SET::PM_FAST );
+                        }
+
+                        if( m_boardAdapter.GetFlag( FL_SUBTRACT_MASK_FROM_SILK ) )
+                        {
+                            if( layer_id == B_SilkS
+                                    && map_poly.find( B_Mask ) != map_poly.end() )
+                            {
+                                polyListSubtracted.BooleanSubtract( *map_poly.at( B_Mask ),
+                                                                    SHAPE_POLY_SET::PM_FAST );
+                            }
+                            else if( layer_id == F_SilkS
+                                    && map_poly.find( F_Mask ) != map_poly.end() )
+                            {
+                                polyListSubtracted.BooleanSubtract( *map_poly.at( F_Mask ),
+                                                                    SHAPE_POLY_SET::PM_FAST );
+                            }
+                        }
                     }
+
+                    polyList = &polyListSubtracted;
                 }
+
+                layerTriangles[layerIdx] = generateLayerTriangles(
+                        container2d, polyList, layer_id, &m_boardAdapter.GetThroughHoleIds() );
             }
 
-            aPolyList = &polyListSubtracted;
-        }
+            threadsFinished++;
+        } );
 
-        OPENGL_RENDER_LIST* oglList = generateLayerList( container2d, aPolyList, layer_id,
-                                                         &m_boardAdapter.GetThroughHoleIds() );
+        t.detach();
+    }
 
-        if( oglList != nullptr )
-            m_layers[layer_id] = oglList;
+    while( threadsFinished < parallelThreadCount )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
 
+    for( size_t ii = 0; ii < layers.size(); ++ii )
+    {
+        if( layerTriangles[ii] != nullptr )
+            m_layers[layers[ii].first] = createLayerList( layerTriangles[ii], layers[ii].first );
     }
 
     if( m_boardAdapter.GetFlag( FL_RENDER_PLATED_PADS_AS_PLATED ) &&
@@ -869,6 +931,24 @@ void RENDER_3D_LEGACY::load3dModels( REPORTER* aStatusReporter )
         return;
     }
 
+    // Let the cache load the models which are not in our map yet all at once, so it can
+    // read them concurrently
+    std::vector<wxString> modelFiles;
+
+    for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
+    {
+        for( const FP_3DMODEL& model : footprint->Models() )
+        {
+            if( model.m_Show && !model.m_Filename.empty()
+                    && m_3dModelMap.find( model.m_Filename ) == m_3dModelMap.end() )
+            {
+                modelFiles.push_back( model.m_Filename );
+            }
+        }
+    }
+
+    m_boardAdapter.Get3dCacheManager()->Preload( modelFiles );
+
     // Go for all footprints
     for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
     {
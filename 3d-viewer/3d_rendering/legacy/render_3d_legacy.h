@@ -83,6 +83,23 @@ private:
                                            PCB_LAYER_ID aLayerId,
                                            const BVH_CONTAINER_2D* aThroughHoles = nullptr );
 
+    /**
+     * Triangulate the items of a layer.  This only reads the board adapter, so layers can be
+     * triangulated concurrently.
+     *
+     * @return the triangles of the layer, or nullptr if the layer has no items.
+     */
+    TRIANGLE_DISPLAY_LIST* generateLayerTriangles(
+            const BVH_CONTAINER_2D* aContainer, const SHAPE_POLY_SET* aPolyList,
+            PCB_LAYER_ID aLayerId, const BVH_CONTAINER_2D* aThroughHoles = nullptr );
+
+    /**
+     * Create the display list of a layer from its triangles, which are then owned by this
+     * renderer.  This must be called from the thread owning the OpenGL context.
+     */
+    OPENGL_RENDER_LIST* createLayerList( TRIANGLE_DISPLAY_LIST* aLayerTriangles,
+                                         PCB_LAYER_ID aLayerId );
+
     void addTopAndBottomTriangles( TRIANGLE_DISPLAY_LIST* aDst, const SFVEC2F& v0,
                                    const SFVEC2F& v1, const SFVEC2F& v2, float top, float bot );
 
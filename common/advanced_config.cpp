@@ -23,6 +23,7 @@
 
 #include <advanced_config.h>
 
+#include <climits>
 #include <config_params.h>
 #include <settings/settings_manager.h>
 
@@ -168,6 +169,8 @@ static const wxChar Skip3DModelMemoryCache[] = wxT( "Skip3DModelMemoryCache" );
 
 static const wxChar HideVersionFromTitle[] = wxT( "HideVersionFromTitle" );
 
+static const wxChar UndoItemBudget[] = wxT( "UndoItemBudget" );
+
 } // namespace KEYS
 
 
@@ -273,6 +276,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_Skip3DModelFileCache      = false;
     m_Skip3DModelMemoryCache    = false;
     m_HideVersionFromTitle      = false;
+    m_UndoItemBudget            = 1000000;
 
     loadFromConfigFile();
 }
@@ -382,6 +386,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::HideVersionFromTitle,
                                                 &m_HideVersionFromTitle, false ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::UndoItemBudget,
+                                               &m_UndoItemBudget, 1000000, 0, INT_MAX ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     dumpCfg( configParams );
@@ -71,6 +71,11 @@ COMMIT& COMMIT::Stage( EDA_ITEM* aItem, CHANGE_TYPE aChangeType )
 
         assert( parent );
 
+        // Don't copy again an item which is already part of the commit, for instance a
+        // footprint whose pads are modified one by one
+        if( parent && m_changedItems.find( parent ) != m_changedItems.end() )
+            return *this;
+
         if( parent )
             clone = parent->Clone();
 
@@ -190,10 +195,14 @@ void COMMIT::makeEntry( EDA_ITEM* aItem, CHANGE_TYPE aType, EDA_ITEM* aCopy )
 
 COMMIT::COMMIT_LINE* COMMIT::findEntry( EDA_ITEM* aItem )
 {
-    for( COMMIT_LINE& change : m_changes )
+    if( m_changedItems.find( aItem ) == m_changedItems.end() )
+        return nullptr;
+
+    // Items are usually looked up right after being staged, so start from the most recent
+    for( auto it = m_changes.rbegin(); it != m_changes.rend(); ++it )
     {
-        if( change.m_item == aItem )
-            return &change;
+        if( it->m_item == aItem )
+            return &*it;
     }
 
     return nullptr;
@@ -33,6 +33,10 @@
 #include <gal/cairo/cairo_compositor.h>
 #include <wx/log.h>
 
+#include <algorithm>
+
+#include <pixman.h>
+
 using namespace KIGFX;
 
 CAIRO_COMPOSITOR::CAIRO_COMPOSITOR( cairo_t** aMainContext ) :
@@ -165,6 +169,44 @@ void CAIRO_COMPOSITOR::Present()
 }
 
 
+void CAIRO_COMPOSITOR::FlushBuffer( unsigned int aBufferHandle )
+{
+    wxASSERT_MSG( aBufferHandle <= usedBuffers(), wxT( "Tried to use a not existing buffer" ) );
+
+    cairo_surface_flush( m_buffers[aBufferHandle - 1].surface );
+}
+
+
+void CAIRO_COMPOSITOR::DrawBufferRows( unsigned int aBufferHandle, unsigned char* aTarget,
+                                       unsigned int aTargetStride, unsigned int aTop,
+                                       unsigned int aBottom )
+{
+    wxASSERT_MSG( aBufferHandle <= usedBuffers(), wxT( "Tried to use a not existing buffer" ) );
+
+    aBottom = std::min( aBottom, m_height );
+
+    if( aTop >= aBottom )
+        return;
+
+    unsigned char* source = (unsigned char*) m_buffers[aBufferHandle - 1].bitmap;
+
+    // Same operation as the cairo_paint() in DrawBuffer(), restricted to the band
+    pixman_image_t* srcImg = pixman_image_create_bits( PIXMAN_a8r8g8b8, m_width, aBottom - aTop,
+                                                       (uint32_t*) ( source + aTop * m_stride ),
+                                                       m_stride );
+    pixman_image_t* dstImg =
+            pixman_image_create_bits( PIXMAN_a8r8g8b8, m_width, aBottom - aTop,
+                                      (uint32_t*) ( aTarget + aTop * aTargetStride ),
+                                      aTargetStride );
+
+    pixman_image_composite( PIXMAN_OP_OVER, srcImg, nullptr, dstImg, 0, 0, 0, 0, 0, 0, m_width,
+                            aBottom - aTop );
+
+    pixman_image_unref( srcImg );
+    pixman_image_unref( dstImg );
+}
+
+
 void CAIRO_COMPOSITOR::clean()
 {
     CAIRO_BUFFERS::const_iterator it;
@@ -38,8 +38,11 @@
 #include <bitmap_base.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <future>
 #include <limits>
+#include <thread>
 
 #include <pixman.h>
 
@@ -1289,27 +1292,82 @@ void CAIRO_GAL::endDrawing()
 {
     CAIRO_GAL_BASE::endDrawing();
 
-    // Merge buffers on the screen
-    m_compositor->DrawBuffer( m_mainBuffer );
-    m_compositor->DrawBuffer( m_overlayBuffer );
+    // Merge buffers on the screen and translate the raw context data from the format stored
+    // by cairo into a format understood by wxImage.  Both steps only touch the pixels of a
+    // single row, so the screen is split into bands of rows processed in parallel.
+    //
+    // Note: this only covers the end of frame copies.  Rasterizing the draw calls, which is
+    // most of the frame time when the view is busy, is still done on this thread.
+    cairo_surface_flush( m_surface );
+    m_compositor->FlushBuffer( m_mainBuffer );
+    m_compositor->FlushBuffer( m_overlayBuffer );
+
+    const bool     littleEndian = wxPlatformInfo::Get().GetEndianness() == wxENDIAN_LITTLE;
+    const unsigned bandCount =
+            ( m_screenSize.y + COMPOSITE_BAND_HEIGHT - 1 ) / COMPOSITE_BAND_HEIGHT;
+
+    auto compositeBand =
+            [&]( unsigned aBand )
+            {
+                unsigned top = aBand * COMPOSITE_BAND_HEIGHT;
+                unsigned bottom = std::min<unsigned>( top + COMPOSITE_BAND_HEIGHT,
+                                                      m_screenSize.y );
+
+                m_compositor->DrawBufferRows( m_mainBuffer, m_bitmapBuffer, m_stride, top,
+                                              bottom );
+                m_compositor->DrawBufferRows( m_overlayBuffer, m_bitmapBuffer, m_stride, top,
+                                              bottom );
+
+                unsigned char* dst = m_wxOutput + top * m_wxBufferWidth * 3;
+                unsigned char* src = m_bitmapBuffer + top * m_wxBufferWidth * 4;
+
+                pixman_image_t* dstImg = pixman_image_create_bits(
+                        littleEndian ? PIXMAN_b8g8r8 : PIXMAN_r8g8b8, m_screenSize.x,
+                        bottom - top, (uint32_t*) dst, m_wxBufferWidth * 3 );
+                pixman_image_t* srcImg = pixman_image_create_bits(
+                        PIXMAN_a8r8g8b8, m_screenSize.x, bottom - top, (uint32_t*) src,
+                        m_wxBufferWidth * 4 );
 
-    // Now translate the raw context data from the format stored
-    // by cairo into a format understood by wxImage.
+                pixman_image_composite( PIXMAN_OP_SRC, srcImg, nullptr, dstImg, 0, 0, 0, 0, 0, 0,
+                                        m_screenSize.x, bottom - top );
 
-    pixman_image_t* dstImg = pixman_image_create_bits(
-            wxPlatformInfo::Get().GetEndianness() == wxENDIAN_LITTLE ? PIXMAN_b8g8r8
-                                                                     : PIXMAN_r8g8b8,
-            m_screenSize.x, m_screenSize.y, (uint32_t*) m_wxOutput, m_wxBufferWidth * 3 );
-    pixman_image_t* srcImg =
-            pixman_image_create_bits( PIXMAN_a8r8g8b8, m_screenSize.x, m_screenSize.y,
-                                      (uint32_t*) m_bitmapBuffer, m_wxBufferWidth * 4 );
+                // Free allocated memory
+                pixman_image_unref( srcImg );
+                pixman_image_unref( dstImg );
+            };
 
-    pixman_image_composite( PIXMAN_OP_SRC, srcImg, nullptr, dstImg, 0, 0, 0, 0, 0, 0,
-                            m_screenSize.x, m_screenSize.y );
+    // The copies are memory bound: give each thread several bands so that small canvases
+    // don't pay for starting threads they can't keep busy.
+    const unsigned minBandsPerThread = 4;
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   bandCount / minBandsPerThread );
+
+    if( parallelThreadCount <= 1 )
+    {
+        for( unsigned band = 0; band < bandCount; ++band )
+            compositeBand( band );
+    }
+    else
+    {
+        std::atomic<unsigned>          nextBand( 0 );
+        std::vector<std::future<void>> returns( parallelThreadCount );
+
+        auto composite_lambda =
+                [&]()
+                {
+                    for( unsigned band = nextBand++; band < bandCount; band = nextBand++ )
+                        compositeBand( band );
+                };
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, composite_lambda );
+
+        for( const std::future<void>& ret : returns )
+            ret.wait();
+    }
 
-    // Free allocated memory
-    pixman_image_unref( srcImg );
-    pixman_image_unref( dstImg );
+    cairo_surface_mark_dirty( m_surface );
 
     wxImage    img( m_wxBufferWidth, m_screenSize.y, m_wxOutput, true );
     wxBitmap   bmp( img );
@@ -283,3 +283,14 @@ wxString KIID_PATH::AsString() const
 
     return path;
 }
+
+
+size_t KIID_PATH::Hash() const
+{
+    size_t hash = 0;
+
+    for( const KIID& kiid : *this )
+        boost::hash_combine( hash, kiid.Hash() );
+
+    return hash;
+}
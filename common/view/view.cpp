@@ -40,6 +40,11 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <painter.h>
 
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
+
 #ifdef KICAD_GAL_PROFILE
 #include <profile.h>
 #endif /* KICAD_GAL_PROFILE  */
@@ -57,7 +62,9 @@ public:
         m_requiredUpdate( KIGFX::NONE ),
         m_drawPriority( 0 ),
         m_groups( nullptr ),
-        m_groupsSize( 0 ) {}
+        m_groupsSize( 0 ),
+        m_lodTile( 0, 0 ),
+        m_hasLodTile( false ) {}
 
     ~VIEW_ITEM_DATA()
     {
@@ -242,6 +249,9 @@ private:
 
     /// Stores layer numbers used by the item.
     std::vector<int> m_layers;
+
+    std::pair<int, int> m_lodTile;      ///< Aggregated drawing tile the item belongs to
+    bool                m_hasLodTile;   ///< Is the item in an aggregated drawing tile?
 };
 
 
@@ -270,7 +280,11 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_lodScale( 0.0 ),
+    m_lodTileSize( 1 ),
+    m_lodValid( false ),
+    m_lodDirty( false )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -303,6 +317,7 @@ VIEW::VIEW( bool aIsDynamic ) :
         m_layers[ii].visible        = true;
         m_layers[ii].displayOnly    = false;
         m_layers[ii].target         = TARGET_CACHED;
+        m_layers[ii].aggregated     = false;
     }
 
     sortLayers();
@@ -359,6 +374,18 @@ void VIEW::Remove( VIEW_ITEM* aItem )
         return;
 
     wxCHECK( viewData->m_view == this, /*void*/ );
+
+    if( viewData->m_hasLodTile )
+    {
+        auto tile = m_lodTiles.find( viewData->m_lodTile );
+
+        if( tile != m_lodTiles.end() )
+            tile->second.dirty = true;
+
+        viewData->m_hasLodTile = false;
+        m_lodDirty = true;
+    }
+
     auto item = std::find( m_allItems->begin(), m_allItems->end(), aItem );
 
     if( item != m_allItems->end() )
@@ -498,7 +525,10 @@ void VIEW::SetGAL( GAL* aGal )
 
     // clear group numbers, so everything is going to be recached
     if( recacheGroups )
+    {
         clearGroupCache();
+        clearLOD();
+    }
 
     // every target has to be refreshed
     MarkDirty();
@@ -767,6 +797,8 @@ void VIEW::UpdateLayerColor( int aLayer )
         m_layers[aLayer].items->Query( r, visitor );
         MarkTargetDirty( m_layers[aLayer].target );
     }
+
+    invalidateLOD();
 }
 
 
@@ -797,6 +829,7 @@ void VIEW::UpdateAllLayersColor()
         }
     }
 
+    invalidateLOD();
     MarkDirty();
 }
 
@@ -995,6 +1028,13 @@ void VIEW::redrawRect( const BOX2I& aRect )
 
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
+
+            if( useLOD( *l ) )
+            {
+                drawLOD( *l, aRect );
+                continue;
+            }
+
             l->items->Query( aRect, drawFunc );
 
             if( m_useDrawPriority )
@@ -1100,6 +1140,23 @@ void VIEW::Clear()
     m_nextDrawPriority = 0;
 
     m_gal->ClearCache();
+
+    // The groups of the aggregated drawings were deleted by ClearCache()
+    clearLOD();
+}
+
+
+void VIEW::BeginBulkLoad()
+{
+    for( VIEW_LAYER& layer : m_layers )
+        layer.items->BeginBulkLoad();
+}
+
+
+void VIEW::EndBulkLoad()
+{
+    for( VIEW_LAYER& layer : m_layers )
+        layer.items->EndBulkLoad();
 }
 
 
@@ -1232,6 +1289,8 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         MarkTargetDirty( m_layers[layerId].target );
     }
 
+    markLODDirty( aItem );
+
     aItem->viewPrivData()->clearUpdateFlags();
 }
 
@@ -1391,6 +1450,52 @@ void VIEW::RecacheAllItems()
             l.items->Query( r, visitor );
         }
     }
+
+    invalidateLOD();
+}
+
+
+void VIEW::prepareItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    std::vector<VIEW_ITEM*> toPrepare;
+
+    // Color changes do not redraw the items
+    for( VIEW_ITEM* item : aItems )
+    {
+        if( item->viewPrivData()->m_requiredUpdate & ( GEOMETRY | LAYERS | REPAINT | INITIAL_ADD ) )
+            toPrepare.push_back( item );
+    }
+
+    // Most frames only redraw a handful of items; starting threads for them would cost more
+    // than it saves.  Only full recaches (board load, RecacheAllItems(), large edits) are split.
+    const size_t minItemsPerThread = 500;
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   toPrepare.size() / minItemsPerThread );
+
+    if( parallelThreadCount <= 1 )
+    {
+        for( VIEW_ITEM* item : toPrepare )
+            item->ViewPrepareDraw();
+
+        return;
+    }
+
+    std::atomic<size_t>            nextItem( 0 );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    auto prepare_lambda =
+            [&]()
+            {
+                for( size_t ii = nextItem++; ii < toPrepare.size(); ii = nextItem++ )
+                    toPrepare[ii]->ViewPrepareDraw();
+            };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, prepare_lambda );
+
+    for( const std::future<void>& ret : returns )
+        ret.wait();
 }
 
 
@@ -1398,17 +1503,235 @@ void VIEW::UpdateItems()
 {
     if( m_gal->IsVisible() )
     {
-        GAL_UPDATE_CONTEXT ctx( m_gal );
+        std::vector<VIEW_ITEM*> toUpdate;
 
         for( VIEW_ITEM* item : *m_allItems )
         {
             if( item->viewPrivData() && item->viewPrivData()->m_requiredUpdate != NONE )
+                toUpdate.push_back( item );
+        }
+
+        bool updateAggregates = m_lodScale > 0.0 && m_scale < m_lodScale
+                                && ( m_lodDirty || !m_lodValid );
+
+        if( toUpdate.empty() && !updateAggregates )
+            return;
+
+        // The GAL is not thread safe, so only the geometry computations can run in parallel.
+        // Items are then drawn serially using the cached geometry.
+        prepareItems( toUpdate );
+
+        GAL_UPDATE_CONTEXT ctx( m_gal );
+
+        for( VIEW_ITEM* item : toUpdate )
+        {
+            invalidateItem( item, item->viewPrivData()->m_requiredUpdate );
+            item->viewPrivData()->m_requiredUpdate = NONE;
+        }
+
+        updateLOD();
+    }
+}
+
+
+void VIEW::SetLODThreshold( double aScale, int aTileSize )
+{
+    wxCHECK( aTileSize > 0, /* void */ );
+
+    if( aTileSize != m_lodTileSize )
+    {
+        for( const std::pair<const std::pair<int, int>, LOD_TILE>& tile : m_lodTiles )
+        {
+            for( const std::pair<const int, int>& group : tile.second.groups )
+                m_gal->DeleteGroup( group.second );
+        }
+
+        clearLOD();
+    }
+
+    m_lodScale = aScale;
+    m_lodTileSize = aTileSize;
+
+    MarkDirty();
+}
+
+
+/**
+ * Return the coordinates of the LOD tile an item belongs to, which is the tile containing the
+ * center of its bounding box.
+ */
+static std::pair<int, int> lodTileOf( const VIEW_ITEM* aItem, int aTileSize )
+{
+    VECTOR2I center = aItem->ViewBBox().Centre();
+
+    return std::make_pair( (int) std::floor( (double) center.x / aTileSize ),
+                           (int) std::floor( (double) center.y / aTileSize ) );
+}
+
+
+bool VIEW::useLOD( const VIEW_LAYER& aLayer ) const
+{
+    // Dirty tiles can only be rebuilt from UpdateItems(), so the items are drawn one by one
+    // until then.
+    return aLayer.aggregated && m_lodScale > 0.0 && m_scale < m_lodScale && m_lodValid
+           && !m_lodDirty && IsCached( aLayer.id );
+}
+
+
+void VIEW::markLODDirty( VIEW_ITEM* aItem )
+{
+    VIEW_ITEM_DATA* viewData = aItem->viewPrivData();
+
+    // Nothing to track until the tiles are built
+    if( !m_lodValid || !viewData )
+        return;
+
+    if( viewData->m_hasLodTile )
+    {
+        auto tile = m_lodTiles.find( viewData->m_lodTile );
+
+        if( tile != m_lodTiles.end() )
+            tile->second.dirty = true;
+
+        viewData->m_hasLodTile = false;
+        m_lodDirty = true;
+    }
+
+    for( int layer : viewData->m_layers )
+    {
+        if( m_layers[layer].aggregated )
+        {
+            viewData->m_lodTile = lodTileOf( aItem, m_lodTileSize );
+            viewData->m_hasLodTile = true;
+            m_lodTiles[ viewData->m_lodTile ].dirty = true;
+            m_lodDirty = true;
+            break;
+        }
+    }
+}
+
+
+void VIEW::invalidateLOD()
+{
+    for( std::pair<const std::pair<int, int>, LOD_TILE>& tile : m_lodTiles )
+        tile.second.dirty = true;
+
+    m_lodDirty = true;
+}
+
+
+void VIEW::clearLOD()
+{
+    m_lodTiles.clear();
+    m_lodValid = false;
+    m_lodDirty = false;
+}
+
+
+void VIEW::updateLOD()
+{
+    if( m_lodScale <= 0.0 || m_scale >= m_lodScale )
+        return;
+
+    if( !m_lodValid )
+    {
+        m_lodValid = true;
+
+        for( VIEW_ITEM* item : *m_allItems )
+        {
+            if( item->viewPrivData() )
             {
-                invalidateItem( item, item->viewPrivData()->m_requiredUpdate );
-                item->viewPrivData()->m_requiredUpdate = NONE;
+                item->viewPrivData()->m_hasLodTile = false;
+                markLODDirty( item );
             }
         }
     }
+
+    if( !m_lodDirty )
+        return;
+
+    for( std::pair<const std::pair<int, int>, LOD_TILE>& entry : m_lodTiles )
+    {
+        const std::pair<int, int>& key = entry.first;
+        LOD_TILE&                  tile = entry.second;
+
+        if( !tile.dirty )
+            continue;
+
+        for( const std::pair<const int, int>& group : tile.groups )
+            m_gal->DeleteGroup( group.second );
+
+        tile.groups.clear();
+        tile.dirty = false;
+
+        BOX2I tileRect( VECTOR2I( key.first, key.second ) * m_lodTileSize,
+                        VECTOR2I( m_lodTileSize, m_lodTileSize ) );
+        bool  emptyBbox = true;
+
+        for( VIEW_LAYER& l : m_layers )
+        {
+            if( !l.aggregated || !l.visible || !IsCached( l.id ) )
+                continue;
+
+            std::vector<VIEW_ITEM*> items;
+
+            auto collect =
+                    [&]( VIEW_ITEM* aItem ) -> bool
+                    {
+                        VIEW_ITEM_DATA* viewData = aItem->viewPrivData();
+
+                        // Items shown or hidden depending on the zoom level are left out
+                        if( viewData && viewData->m_hasLodTile && viewData->m_lodTile == key
+                                && viewData->isRenderable()
+                                && aItem->ViewGetLOD( l.id, this ) <= 0.0 )
+                        {
+                            items.push_back( aItem );
+                        }
+
+                        return true;
+                    };
+
+            l.items->Query( tileRect, collect );
+
+            if( items.empty() )
+                continue;
+
+            m_gal->SetTarget( l.target );
+            m_gal->SetLayerDepth( l.renderingOrder );
+
+            int group = m_gal->BeginGroup();
+
+            for( VIEW_ITEM* item : items )
+            {
+                if( !m_painter->DrawLOD( item, l.id ) && !m_painter->Draw( item, l.id ) )
+                    item->ViewDraw( l.id, this );
+
+                if( emptyBbox )
+                    tile.bbox = item->ViewBBox();
+                else
+                    tile.bbox.Merge( item->ViewBBox() );
+
+                emptyBbox = false;
+            }
+
+            m_gal->EndGroup();
+            tile.groups[ l.id ] = group;
+        }
+    }
+
+    m_lodDirty = false;
+}
+
+
+void VIEW::drawLOD( const VIEW_LAYER& aLayer, const BOX2I& aRect )
+{
+    for( const std::pair<const std::pair<int, int>, LOD_TILE>& tile : m_lodTiles )
+    {
+        auto group = tile.second.groups.find( aLayer.id );
+
+        if( group != tile.second.groups.end() && tile.second.bbox.Intersects( aRect ) )
+            m_gal->DrawGroup( group->second );
+    }
 }
 
 
@@ -26,9 +26,11 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <profile.h>
 #include <common.h>
 #include <erc.h>
+#include <hash_eda.h>
 #include <pin_type.h>
 #include <sch_bus_entry.h>
 #include <sch_symbol.h>
@@ -437,36 +439,139 @@ void CONNECTION_GRAPH::Reset()
 }
 
 
+/**
+ * @return a hash of everything the item links and dangling states of a screen depend on: its
+ *         items, their layers, end points and connection points, and the pins of its symbols
+ *         and sheets.
+ * @param aHasDirtyItems is set when a connectable item has never been linked.  A new item can
+ *                       take the address of a deleted one, which the hash alone can't tell.
+ */
+static size_t linkSignature( SCH_SCREEN* aScreen, bool& aHasDirtyItems )
+{
+    size_t                         seed = 0;
+    std::vector<DANGLING_END_ITEM> endPoints;
+
+    auto addConnectionPoints =
+            [&]( SCH_ITEM* aItem )
+            {
+                hash_combine( seed, aItem );
+
+                for( const wxPoint& pt : aItem->GetConnectionPoints() )
+                    hash_combine( seed, pt.x, pt.y );
+            };
+
+    for( SCH_ITEM* item : aScreen->Items() )
+    {
+        hash_combine( seed, item, static_cast<int>( item->GetLayer() ) );
+
+        endPoints.clear();
+        item->GetEndPoints( endPoints );
+
+        for( const DANGLING_END_ITEM& end : endPoints )
+        {
+            hash_combine( seed, end.GetItem(), static_cast<int>( end.GetType() ),
+                          end.GetPosition().x, end.GetPosition().y );
+        }
+
+        if( !item->IsConnectable() )
+            continue;
+
+        if( item->IsConnectivityDirty() )
+            aHasDirtyItems = true;
+
+        addConnectionPoints( item );
+
+        if( item->Type() == SCH_SYMBOL_T )
+        {
+            for( std::unique_ptr<SCH_PIN>& pin : static_cast<SCH_SYMBOL*>( item )->GetRawPins() )
+                addConnectionPoints( pin.get() );
+        }
+        else if( item->Type() == SCH_SHEET_T )
+        {
+            for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
+                addConnectionPoints( pin );
+        }
+    }
+
+    return seed;
+}
+
+
 void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional,
                                     std::function<void( SCH_ITEM* )>* aChangedItemHandler )
 {
     PROF_COUNTER recalc_time( "CONNECTION_GRAPH::Recalculate" );
 
+    // Item links only depend on the items of their own screen, so the links of sheets whose
+    // screen is unchanged since the last update can be reused.  Changes are found by comparing
+    // the link signature of each screen with the one of the previous update, so callers don't
+    // have to flag the items they edit.  The graph itself (subgraphs, drivers, net names) is
+    // global and is always rebuilt.
+    std::unordered_set<SCH_SCREEN*>    dirtyScreens;
+    std::unordered_set<SCH_SHEET_PATH> previousSheets;
+
     if( aUnconditional )
-        Reset();
+    {
+        m_screenSignatures.clear();
+    }
+    else
+    {
+        std::unordered_map<SCH_SCREEN*, size_t> signatures;
 
-    PROF_COUNTER update_items( "updateItemConnectivity" );
+        previousSheets.insert( m_sheetList.begin(), m_sheetList.end() );
 
-    m_sheetList = aSheetList;
+        for( const SCH_SHEET_PATH& sheet : aSheetList )
+        {
+            SCH_SCREEN* screen = sheet.LastScreen();
+
+            if( signatures.count( screen ) )
+                continue;
+
+            bool   hasDirtyItems = false;
+            size_t signature = linkSignature( screen, hasDirtyItems );
+            auto   previous = m_screenSignatures.find( screen );
+
+            if( hasDirtyItems || previous == m_screenSignatures.end()
+                    || previous->second != signature )
+            {
+                dirtyScreens.insert( screen );
+            }
+
+            signatures[ screen ] = signature;
+        }
+
+        m_screenSignatures = std::move( signatures );
+    }
+
+    Reset();
+
+    PROF_COUNTER update_items( "updateItemConnectivity" );
 
     for( const SCH_SHEET_PATH& sheet : aSheetList )
     {
+        SCH_SCREEN* screen = sheet.LastScreen();
+        bool        dirty  = aUnconditional || dirtyScreens.count( screen )
+                                            || !previousSheets.count( sheet );
+
         std::vector<SCH_ITEM*> items;
 
-        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+        for( SCH_ITEM* item : screen->Items() )
         {
-            if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
+            if( item->IsConnectable() )
                 items.push_back( item );
         }
 
         m_items.reserve( m_items.size() + items.size() );
 
-        updateItemConnectivity( sheet, items );
+        updateItemConnectivity( sheet, items, dirty );
 
         // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+        if( dirty )
+            screen->TestDanglingEnds( &sheet, aChangedItemHandler );
     }
 
+    m_sheetList = aSheetList;
+
     if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
         update_items.Show();
 
@@ -496,25 +601,34 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 
 
 void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
-                                               const std::vector<SCH_ITEM*>& aItemList )
+                                               const std::vector<SCH_ITEM*>& aItemList,
+                                               bool aUpdateLinks )
 {
     std::map< wxPoint, std::vector<SCH_ITEM*> > connection_map;
 
     for( SCH_ITEM* item : aItemList )
     {
-        std::vector< wxPoint > points = item->GetConnectionPoints();
-        item->ConnectedItems( aSheet ).clear();
+        std::vector< wxPoint > points;
+
+        if( aUpdateLinks )
+        {
+            points = item->GetConnectionPoints();
+            item->ConnectedItems( aSheet ).clear();
+        }
 
         if( item->Type() == SCH_SHEET_T )
         {
             for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
             {
                 pin->InitializeConnection( aSheet, this );
+                m_items.emplace_back( pin );
+
+                if( !aUpdateLinks )
+                    continue;
 
                 pin->ConnectedItems( aSheet ).clear();
 
                 connection_map[ pin->GetTextPos() ].push_back( pin );
-                m_items.emplace_back( pin );
             }
         }
         else if( item->Type() == SCH_SYMBOL_T )
@@ -529,15 +643,19 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
                 // because calling the first time is not thread-safe
                 pin->GetDefaultNetName( aSheet );
-                pin->ConnectedItems( aSheet ).clear();
 
                 // Invisible power pins need to be post-processed later
 
                 if( pin->IsPowerConnection() && !pin->IsVisible() )
                     m_invisible_power_pins.emplace_back( std::make_pair( aSheet, pin ) );
 
-                connection_map[ pos ].push_back( pin );
                 m_items.emplace_back( pin );
+
+                if( !aUpdateLinks )
+                    continue;
+
+                pin->ConnectedItems( aSheet ).clear();
+                connection_map[ pos ].push_back( pin );
             }
         }
         else
@@ -555,9 +673,14 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             case SCH_BUS_BUS_ENTRY_T:
                 conn->SetType( CONNECTION_TYPE::BUS );
+
                 // clean previous (old) links:
-                static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[0] = nullptr;
-                static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
+                if( aUpdateLinks )
+                {
+                    static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[0] = nullptr;
+                    static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
+                }
+
                 break;
 
             case SCH_PIN_T:
@@ -566,8 +689,11 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             case SCH_BUS_WIRE_ENTRY_T:
                 conn->SetType( CONNECTION_TYPE::NET );
+
                 // clean previous (old) link:
-                static_cast<SCH_BUS_WIRE_ENTRY*>( item )->m_connected_bus_item = nullptr;
+                if( aUpdateLinks )
+                    static_cast<SCH_BUS_WIRE_ENTRY*>( item )->m_connected_bus_item = nullptr;
+
                 break;
 
             default:
@@ -581,6 +707,9 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         item->SetConnectivityDirty( false );
     }
 
+    if( !aUpdateLinks )
+        return;
+
     for( const auto& it : connection_map )
     {
         auto connection_vec = it.second;
@@ -270,6 +270,13 @@ public:
     /**
      * Updates the connection graph for the given list of sheets.
      *
+     * When \a aUnconditional is false, only the sheets whose items, positions or pins changed
+     * since the previous incremental recalculation (or which were not part of the previous
+     * sheet list) have their item links and dangling states rebuilt.  Items on unmodified sheets keep their links and are only
+     * re-entered into the graph, which is then rebuilt as a whole: subgraphs, drivers and net
+     * names are always recomputed for every sheet, so the cost of a recalculation still grows
+     * with the size of the design.
+     *
      * @param aSheetList is the list of possibly modified sheets
      * @param aUnconditional is true if an unconditional full recalculation should be done
      * @param aChangedItemHandler an optional handler to receive any changed items
@@ -351,9 +358,12 @@ private:
      *
      * @param aSheet is the path to the sheet of all items in the list
      * @param aItemList is a list of items to consider
+     * @param aUpdateLinks is false to only reinitialize the connections of items whose
+     *                     graphical links are still valid (the second phase is skipped)
      */
     void updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
-                                 const std::vector<SCH_ITEM*>& aItemList );
+                                 const std::vector<SCH_ITEM*>& aItemList,
+                                 bool aUpdateLinks = true );
 
     /**
      * Generates the connection graph (after all item connectivity has been updated)
@@ -508,9 +518,12 @@ public:
     static bool m_allowRealTime;
 
 private:
-    // All the sheets in the schematic (as long as we don't have partial updates)
+    // All the sheets in the schematic at the last recalculation
     SCH_SHEET_LIST m_sheetList;
 
+    // Link signature of each screen at the last incremental recalculation
+    std::unordered_map<SCH_SCREEN*, size_t> m_screenSignatures;
+
     // All connectable items in the schematic
     std::vector<SCH_ITEM*> m_items;
 
@@ -21,6 +21,10 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <set>
+#include <thread>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code.
@@ -291,6 +295,15 @@ static void formatStroke( OUTPUTFORMATTER* aFormatter, int aNestLevel,
  */
 class SCH_SEXPR_PLUGIN_CACHE
 {
+    /// Location of a top level symbol definition in the library file.
+    struct SYMBOL_INDEX_ENTRY
+    {
+        size_t   m_offset;          // Offset of the opening parenthesis in the file.
+        size_t   m_length;
+        wxString m_parent;          // Name of the symbol this one extends, if any.
+        bool     m_isPower;
+    };
+
     static int      m_modHash;      // Keep track of the modification status of the library.
 
     wxString        m_fileName;     // Absolute path and file name.
@@ -302,8 +315,32 @@ class SCH_SEXPR_PLUGIN_CACHE
     int             m_versionMajor;
     SCH_LIB_TYPE    m_libType;      // Is this cache a symbol or symbol library.
 
+    /// Symbols of the library file not parsed yet.  Symbols are moved to #m_symbols when
+    /// they are parsed.
+    std::map<wxString, SYMBOL_INDEX_ENTRY> m_index;
+    int                                    m_fileVersion;
+
     LIB_SYMBOL*       removeSymbol( LIB_SYMBOL* aAlias );
 
+    /**
+     * Build #m_index from the library file contents in a single pass, without parsing the
+     * symbols.
+     *
+     * @return false if the contents are not a well formed symbol library.
+     */
+    bool buildIndex( const std::string& aContents );
+
+    /**
+     * Parse an indexed symbol, and the symbol it extends first if needed.  The symbol is only
+     * removed from #m_index once it has been parsed.
+     *
+     * @param aDepth is the number of derived symbols waiting on this one, used to detect
+     *               circular inheritance.
+     */
+    LIB_SYMBOL* loadIndexedSymbol( const wxString& aName, size_t aDepth = 0 );
+
+    bool isIndexedPower( const SYMBOL_INDEX_ENTRY& aEntry ) const;
+
     static void     saveSymbolDrawItem( LIB_ITEM* aItem, OUTPUTFORMATTER& aFormatter,
                                         int aNestLevel );
     static void     saveArc( LIB_ARC* aArc, OUTPUTFORMATTER& aFormatter, int aNestLevel = 0 );
@@ -338,8 +375,21 @@ public:
     /// Save the entire library to file m_libFileName;
     void Save();
 
+    /**
+     * Index the symbols of the library file.  Symbols are only parsed when requested with
+     * #GetSymbol() or when the whole library is needed (#LoadAll()).
+     */
     void Load();
 
+    /// Parse all of the indexed symbols not parsed yet.
+    void LoadAll();
+
+    /// @return the symbol \a aName, parsing it if needed, or nullptr if it does not exist.
+    LIB_SYMBOL* GetSymbol( const wxString& aName );
+
+    /// Add the names of the symbols of the library to \a aNames, without parsing them.
+    void GetSymbolNames( wxArrayString& aNames, bool aPowerSymbolsOnly );
+
     void AddSymbol( const LIB_SYMBOL* aSymbol );
 
     void DeleteSymbol( const wxString& aName );
@@ -357,7 +407,12 @@ public:
 
     wxString GetLogicalName() const { return m_libFileName.GetName(); }
 
-    void SetFileName( const wxString& aFileName ) { m_libFileName = aFileName; }
+    void SetFileName( const wxString& aFileName )
+    {
+        // Indexed symbols can only be parsed from the file they were indexed from.
+        LoadAll();
+        m_libFileName = aFileName;
+    }
 
     wxString GetFileName() const { return m_libFileName.GetFullPath(); }
 
@@ -465,74 +520,177 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
 }
 
 
-// Everything below this comment is recursive.  Modify with care.
-
 void SCH_SEXPR_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
 {
-    SCH_SCREEN* screen = NULL;
+    // The hierarchy is loaded one level at a time.  The sub-sheet file names of a level are
+    // only known once their parent files are parsed, but all of the files of a level are
+    // independent and are parsed concurrently.  Each file is parsed into its own SCH_SCREEN
+    // so the parsers share no state.
+    struct LOAD_JOB
+    {
+        SCH_SHEET* m_sheet;
+        wxString   m_fileName;
+        wxString   m_error;
+    };
 
-    if( !aSheet->GetScreen() )
+    // Sheets to load, along with the path their file name is relative to
+    std::vector<std::pair<SCH_SHEET*, wxString>> pending = { { aSheet, m_currentPath.top() } };
+
+    while( !pending.empty() )
     {
-        // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
-        // stores the file name and extension.  Add the project path to the file name and
-        // extension to compare when calling SCH_SHEET::SearchHierarchy().
-        wxFileName fileName = aSheet->GetFileName();
+        std::vector<LOAD_JOB> jobs;
+
+        for( const std::pair<SCH_SHEET*, wxString>& entry : pending )
+        {
+            SCH_SHEET* sheet = entry.first;
 
-        if( !fileName.IsAbsolute() )
-            fileName.MakeAbsolute( m_currentPath.top() );
+            if( sheet->GetScreen() )
+                continue;
 
-        // Save the current path so that it gets restored when descending and ascending the
-        // sheet hierarchy which allows for sheet schematic files to be nested in folders
-        // relative to the last path a schematic was loaded from.
-        wxLogTrace( traceSchLegacyPlugin, "Saving path    '%s'", m_currentPath.top() );
-        m_currentPath.push( fileName.GetPath() );
-        wxLogTrace( traceSchLegacyPlugin, "Current path   '%s'", m_currentPath.top() );
-        wxLogTrace( traceSchLegacyPlugin, "Loading        '%s'", fileName.GetFullPath() );
+            // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object
+            // only stores the file name and extension.  Add the path of the parent sheet file to
+            // the file name and extension to compare when calling SCH_SHEET::SearchHierarchy().
+            // This allows for sheet schematic files to be nested in folders relative to the
+            // sheet they were loaded from.
+            wxFileName fileName = sheet->GetFileName();
 
-        m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+            if( !fileName.IsAbsolute() )
+                fileName.MakeAbsolute( entry.second );
 
-        if( screen )
+            SCH_SCREEN* screen = nullptr;
+
+            // Screens created for this level have their file name set already, so sheets
+            // sharing a file are only loaded once.
+            m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+
+            if( screen )
+            {
+                sheet->SetScreen( screen );
+                sheet->GetScreen()->SetParent( m_schematic );
+                // Do not need to load the sub-sheets - this has already been done.
+                continue;
+            }
+
+            wxLogTrace( traceSchLegacyPlugin, "Loading        '%s'", fileName.GetFullPath() );
+
+            sheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+            sheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+
+            jobs.push_back( { sheet, fileName.GetFullPath(), wxEmptyString } );
+        }
+
+        std::atomic<size_t> nextJob( 0 );
+
+        auto load_lambda =
+                [&]( bool aInline ) -> size_t
+                {
+                    size_t num = 0;
+
+                    for( size_t i = nextJob++; i < jobs.size(); i = nextJob++ )
+                    {
+                        LOAD_JOB& job = jobs[i];
+
+                        if( m_progressReporter && m_progressReporter->IsCancelled() )
+                            break;
+
+                        try
+                        {
+                            if( aInline )
+                            {
+                                loadFile( job.m_fileName, job.m_sheet );
+                            }
+                            else
+                            {
+                                // The progress reporter can only be refreshed from the main
+                                // thread, so only report the file being loaded.
+                                if( m_progressReporter )
+                                {
+                                    m_progressReporter->Report(
+                                            wxString::Format( _( "Loading %s..." ),
+                                                              job.m_fileName ) );
+                                }
+
+                                FILE_LINE_READER reader( job.m_fileName );
+                                SCH_SEXPR_PARSER parser( &reader );
+
+                                parser.ParseSchematic( job.m_sheet );
+                            }
+                        }
+                        catch( const IO_ERROR& ioe )
+                        {
+                            // If there is a problem loading the root sheet, there is no
+                            // recovery.  The root sheet is always loaded alone, on this thread.
+                            if( job.m_sheet == m_rootSheet )
+                                throw;
+
+                            job.m_error = ioe.What();
+                        }
+
+                        num++;
+                    }
+
+                    return num;
+                };
+
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                       jobs.size() );
+
+        if( parallelThreadCount <= 1 )
         {
-            aSheet->SetScreen( screen );
-            aSheet->GetScreen()->SetParent( m_schematic );
-            // Do not need to load the sub-sheets - this has already been done.
+            load_lambda( true );
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+            std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-            try
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, load_lambda, false );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                // Here we balance returns with a 100ms timeout to allow UI updating
+                std::future_status status;
+                do
+                {
+                    if( m_progressReporter )
+                        m_progressReporter->KeepRefreshing();
+
+                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+                } while( status != std::future_status::ready );
             }
-            catch( const IO_ERROR& ioe )
-            {
-                // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw;
 
-                // For all subsheets, queue up the error message for the caller.
+            // Rethrow anything the workers did not handle themselves, only once all of them
+            // are done with the jobs list
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii].get();
+        }
+
+        if( m_progressReporter && m_progressReporter->IsCancelled() )
+            THROW_IO_ERROR( ( "Open cancelled by user." ) );
+
+        pending.clear();
+
+        for( const LOAD_JOB& job : jobs )
+        {
+            // For all subsheets, queue up the error message for the caller.
+            if( !job.m_error.IsEmpty() )
+            {
                 if( !m_error.IsEmpty() )
                     m_error += "\n";
 
-                m_error += ioe.What();
+                m_error += job.m_error;
             }
 
-            // This was moved out of the try{} block so that any sheets definitionsthat
-            // the plugin fully parsed before the exception was raised will be loaded.
-            for( SCH_ITEM* aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+            // Any sheet definitions the parser fully parsed before an exception was raised
+            // are loaded too.
+            wxString path = wxFileName( job.m_fileName ).GetPath();
+
+            for( SCH_ITEM* aItem : job.m_sheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
             {
                 wxCHECK2( aItem->Type() == SCH_SHEET_T, /* do nothing */ );
-                SCH_SHEET* sheet = static_cast<SCH_SHEET*>( aItem );
-
-                // Recursion starts here.
-                loadHierarchy( sheet );
+                pending.emplace_back( static_cast<SCH_SHEET*>( aItem ), path );
             }
         }
-
-        m_currentPath.pop();
-        wxLogTrace( traceSchLegacyPlugin, "Restoring path \"%s\"", m_currentPath.top() );
     }
 }
 
@@ -1381,6 +1539,7 @@ SCH_SEXPR_PLUGIN_CACHE::SCH_SEXPR_PLUGIN_CACHE( const wxString& aFullPathAndFile
 {
     m_versionMajor = -1;
     m_libType      = SCH_LIB_TYPE::LT_EESCHEMA;
+    m_fileVersion  = SEXPR_SYMBOL_LIB_FILE_VERSION;
 }
 
 
@@ -1499,6 +1658,9 @@ LIB_SYMBOL* SCH_SEXPR_PLUGIN_CACHE::removeSymbol( LIB_SYMBOL* aSymbol )
 
 void SCH_SEXPR_PLUGIN_CACHE::AddSymbol( const LIB_SYMBOL* aSymbol )
 {
+    // Replacing a root symbol reparents its aliases, so they all need to be loaded.
+    LoadAll();
+
     // aSymbol is cloned in SYMBOL_LIB::AddSymbol().  The cache takes ownership of aSymbol.
     wxString name = aSymbol->GetName();
     LIB_SYMBOL_MAP::iterator it = m_symbols.find( name );
@@ -1533,11 +1695,37 @@ void SCH_SEXPR_PLUGIN_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    std::string contents;
+
+    {
+        FILE* fp = wxFopen( m_libFileName.GetFullPath(), wxT( "rb" ) );
+
+        if( !fp )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Unable to open library file '%s'." ),
+                                              m_libFileName.GetFullPath() ) );
+        }
+
+        char   buf[65536];
+        size_t count;
 
-    SCH_SEXPR_PARSER parser( &reader );
+        while( ( count = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+            contents.append( buf, count );
+
+        fclose( fp );
+    }
+
+    if( !buildIndex( contents ) )
+    {
+        // Let the parser report what is wrong with the file.
+        m_index.clear();
+
+        STRING_LINE_READER reader( contents, m_libFileName.GetFullPath() );
+        SCH_SEXPR_PARSER   parser( &reader );
+
+        parser.ParseLib( m_symbols );
+    }
 
-    parser.ParseLib( m_symbols );
     ++m_modHash;
 
     // Remember the file modification time of library file when the
@@ -1547,6 +1735,241 @@ void SCH_SEXPR_PLUGIN_CACHE::Load()
 }
 
 
+/**
+ * Read the token starting at \a aPos in \a aContents: either a quoted string, whose escapes
+ * are resolved, or a bare symbol.
+ *
+ * @return the position following the token.
+ */
+static size_t readIndexToken( const std::string& aContents, size_t aPos, std::string& aToken )
+{
+    aToken.clear();
+
+    while( aPos < aContents.size() && isspace( (unsigned char) aContents[aPos] ) )
+        aPos++;
+
+    if( aPos < aContents.size() && aContents[aPos] == '"' )
+    {
+        for( aPos++; aPos < aContents.size() && aContents[aPos] != '"'; aPos++ )
+        {
+            if( aContents[aPos] == '\\' && aPos + 1 < aContents.size() )
+                aPos++;
+
+            aToken += aContents[aPos];
+        }
+
+        return aPos + 1;
+    }
+
+    while( aPos < aContents.size() && !isspace( (unsigned char) aContents[aPos] )
+           && aContents[aPos] != '(' && aContents[aPos] != ')' )
+    {
+        aToken += aContents[aPos++];
+    }
+
+    return aPos;
+}
+
+
+bool SCH_SEXPR_PLUGIN_CACHE::buildIndex( const std::string& aContents )
+{
+    // The library is a flat list of top level symbols:
+    //
+    //     (kicad_symbol_lib (version ...) (generator ...)
+    //       (symbol "name" (power) (extends "parent") ... )
+    //       ...
+    //     )
+    //
+    // so only the nesting depth and the strings need to be tracked to find them.
+    std::string        token;
+    int                depth = 0;
+    bool               inSymbol = false;
+    wxString           name;
+    SYMBOL_INDEX_ENTRY entry;
+
+    m_index.clear();
+
+    for( size_t pos = 0; pos < aContents.size(); pos++ )
+    {
+        char c = aContents[pos];
+
+        if( c == '"' )
+        {
+            // Skip strings, which may contain parentheses
+            for( pos++; pos < aContents.size() && aContents[pos] != '"'; pos++ )
+            {
+                if( aContents[pos] == '\\' )
+                    pos++;
+            }
+        }
+        else if( c == '(' )
+        {
+            size_t start = pos;
+
+            depth++;
+            pos = readIndexToken( aContents, pos + 1, token ) - 1;
+
+            if( depth == 1 && token != "kicad_symbol_lib" )
+            {
+                return false;
+            }
+            else if( depth == 2 && token == "version" )
+            {
+                pos = readIndexToken( aContents, pos + 1, token ) - 1;
+                m_fileVersion = atoi( token.c_str() );
+            }
+            else if( depth == 2 && token == "symbol" )
+            {
+                pos = readIndexToken( aContents, pos + 1, token ) - 1;
+
+                LIB_ID id;
+
+                if( id.Parse( token ) >= 0 )
+                    return false;
+
+                inSymbol = true;
+                name = id.GetLibItemName().wx_str();
+                entry = SYMBOL_INDEX_ENTRY{ start, 0, wxEmptyString, false };
+            }
+            else if( depth == 3 && inSymbol && token == "power" )
+            {
+                entry.m_isPower = true;
+            }
+            else if( depth == 3 && inSymbol && token == "extends" )
+            {
+                pos = readIndexToken( aContents, pos + 1, token ) - 1;
+                entry.m_parent = FROM_UTF8( token.c_str() );
+            }
+        }
+        else if( c == ')' )
+        {
+            if( depth == 2 && inSymbol )
+            {
+                entry.m_length = pos + 1 - entry.m_offset;
+
+                if( m_symbols.find( name ) == m_symbols.end() )
+                    m_index[name] = entry;
+
+                inSymbol = false;
+            }
+
+            if( --depth < 0 )
+                return false;
+        }
+    }
+
+    return depth == 0;
+}
+
+
+LIB_SYMBOL* SCH_SEXPR_PLUGIN_CACHE::loadIndexedSymbol( const wxString& aName, size_t aDepth )
+{
+    auto it = m_index.find( aName );
+
+    if( it == m_index.end() )
+        return nullptr;
+
+    // A chain of parents longer than the index must loop back on itself.
+    if( aDepth >= m_index.size() )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Symbol '%s' in library file '%s' inherits from "
+                                             "itself." ),
+                                          aName, m_libFileName.GetFullPath() ) );
+    }
+
+    SYMBOL_INDEX_ENTRY entry = it->second;
+
+    // The parser resolves "extends" from the symbols already loaded.
+    if( !entry.m_parent.IsEmpty() && m_symbols.find( entry.m_parent ) == m_symbols.end() )
+        loadIndexedSymbol( entry.m_parent, aDepth + 1 );
+
+    std::string bytes( entry.m_length, '\0' );
+    FILE*       fp = wxFopen( m_libFileName.GetFullPath(), wxT( "rb" ) );
+    bool        ok = fp && fseek( fp, entry.m_offset, SEEK_SET ) == 0
+                        && fread( &bytes[0], 1, entry.m_length, fp ) == entry.m_length;
+
+    if( fp )
+        fclose( fp );
+
+    if( !ok )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Unable to read symbol '%s' from library file '%s'." ),
+                                          aName, m_libFileName.GetFullPath() ) );
+    }
+
+    STRING_LINE_READER reader( bytes, m_libFileName.GetFullPath() );
+    SCH_SEXPR_PARSER   parser( &reader );
+
+    parser.NeedLEFT();
+    parser.NextTok();
+
+    LIB_SYMBOL* symbol = parser.ParseSymbol( m_symbols, m_fileVersion );
+    m_symbols[symbol->GetName()] = symbol;
+
+    // Only forget the entry once the symbol is loaded, so that a failed parse can be retried
+    // or reported again.
+    m_index.erase( aName );
+
+    return symbol;
+}
+
+
+bool SCH_SEXPR_PLUGIN_CACHE::isIndexedPower( const SYMBOL_INDEX_ENTRY& aEntry ) const
+{
+    // Derived symbols take the power flag of their parent, see LIB_SYMBOL::IsPower().
+    if( aEntry.m_parent.IsEmpty() )
+        return aEntry.m_isPower;
+
+    auto parent = m_symbols.find( aEntry.m_parent );
+
+    if( parent != m_symbols.end() )
+        return parent->second->IsPower();
+
+    auto indexedParent = m_index.find( aEntry.m_parent );
+
+    return indexedParent != m_index.end() && indexedParent->second.m_isPower;
+}
+
+
+void SCH_SEXPR_PLUGIN_CACHE::LoadAll()
+{
+    while( !m_index.empty() )
+        loadIndexedSymbol( m_index.begin()->first );
+}
+
+
+LIB_SYMBOL* SCH_SEXPR_PLUGIN_CACHE::GetSymbol( const wxString& aName )
+{
+    LIB_SYMBOL_MAP::const_iterator it = m_symbols.find( aName );
+
+    if( it != m_symbols.end() )
+        return it->second;
+
+    return loadIndexedSymbol( aName );
+}
+
+
+void SCH_SEXPR_PLUGIN_CACHE::GetSymbolNames( wxArrayString& aNames, bool aPowerSymbolsOnly )
+{
+    std::set<wxString> names;
+
+    for( const std::pair<const wxString, LIB_SYMBOL*>& symbol : m_symbols )
+    {
+        if( !aPowerSymbolsOnly || symbol.second->IsPower() )
+            names.insert( symbol.first );
+    }
+
+    for( const std::pair<const wxString, SYMBOL_INDEX_ENTRY>& entry : m_index )
+    {
+        if( !aPowerSymbolsOnly || isIndexedPower( entry.second ) )
+            names.insert( entry.first );
+    }
+
+    for( const wxString& name : names )
+        aNames.Add( name );
+}
+
+
 void SCH_SEXPR_PLUGIN_CACHE::Save()
 {
     if( !m_isModified )
@@ -1554,6 +1977,8 @@ void SCH_SEXPR_PLUGIN_CACHE::Save()
 
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
+    LoadAll();
+
     // Write through symlinks, don't replace them.
     wxFileName fn = GetRealFile();
 
@@ -2075,6 +2500,9 @@ void SCH_SEXPR_PLUGIN_CACHE::saveText( LIB_TEXT* aText, OUTPUTFORMATTER& aFormat
 
 void SCH_SEXPR_PLUGIN_CACHE::DeleteSymbol( const wxString& aSymbolName )
 {
+    // Deleting a root symbol deletes its aliases, so they all need to be loaded.
+    LoadAll();
+
     LIB_SYMBOL_MAP::iterator it = m_symbols.find( aSymbolName );
 
     if( it == m_symbols.end() )
@@ -2166,13 +2594,7 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
 
     cacheLib( aLibraryPath, aProperties );
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
-
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
-    {
-        if( !powerSymbolsOnly || it->second->IsPower() )
-            aSymbolNameList.Add( it->first );
-    }
+    m_cache->GetSymbolNames( aSymbolNameList, powerSymbolsOnly );
 }
 
 
@@ -2187,12 +2609,15 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList
 
     cacheLib( aLibraryPath, aProperties );
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
+    wxArrayString names;
+
+    // Only the requested symbols are parsed
+    m_cache->GetSymbolNames( names, powerSymbolsOnly );
 
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
+    for( const wxString& name : names )
     {
-        if( !powerSymbolsOnly || it->second->IsPower() )
-            aSymbolList.push_back( it->second );
+        if( LIB_SYMBOL* symbol = m_cache->GetSymbol( name ) )
+            aSymbolList.push_back( symbol );
     }
 }
 
@@ -2204,12 +2629,7 @@ LIB_SYMBOL* SCH_SEXPR_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wx
 
     cacheLib( aLibraryPath, aProperties );
 
-    LIB_SYMBOL_MAP::const_iterator it = m_cache->m_symbols.find( aSymbolName );
-
-    if( it == m_cache->m_symbols.end() )
-        return nullptr;
-
-    return it->second;
+    return m_cache->GetSymbol( aSymbolName );
 }
 
 
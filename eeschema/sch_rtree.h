@@ -47,6 +47,7 @@ public:
     {
         this->m_tree = new ee_rtree();
         m_count      = 0;
+        m_bulkLoading = false;
     }
 
     ~EE_RTREE()
@@ -64,10 +65,49 @@ public:
         const int       mmin[3] = { type, bbox.GetX(), bbox.GetY() };
         const int       mmax[3] = { type, bbox.GetRight(), bbox.GetBottom() };
 
-        m_tree->Insert( mmin, mmax, aItem );
+        if( m_bulkLoading )
+            m_pending.emplace_back( ee_rtree::Rect{ { mmin[0], mmin[1], mmin[2] },
+                                                    { mmax[0], mmax[1], mmax[2] } },
+                                    aItem );
+        else
+            m_tree->Insert( mmin, mmax, aItem );
+
         m_count++;
     }
 
+    /**
+     * Start collecting the items passed to insert() instead of inserting them one by one.
+     *
+     * The collected items can neither be found nor iterated over until EndBulkLoad() has been
+     * called.
+     */
+    void BeginBulkLoad()
+    {
+        m_bulkLoading = true;
+    }
+
+    /**
+     * Add the items collected since BeginBulkLoad() to the tree.  An empty tree is packed from
+     * them at once, which is much faster than inserting them one by one.
+     */
+    void EndBulkLoad()
+    {
+        m_bulkLoading = false;
+
+        if( m_count == m_pending.size() )
+        {
+            m_tree->BulkLoad( m_pending );
+        }
+        else
+        {
+            for( const std::pair<ee_rtree::Rect, SCH_ITEM*>& entry : m_pending )
+                m_tree->Insert( entry.first.m_min, entry.first.m_max, entry.second );
+        }
+
+        m_pending.clear();
+        m_pending.shrink_to_fit();
+    }
+
     /**
      * Remove an item from the tree. Removal is done by comparing pointers, attempting
      * to remove a copy of the item will fail.
@@ -104,7 +144,9 @@ public:
     void clear()
     {
         m_tree->RemoveAll();
+        m_pending.clear();
         m_count = 0;
+        m_bulkLoading = false;
     }
 
     /**
@@ -267,6 +309,43 @@ public:
 private:
     ee_rtree* m_tree;
     size_t    m_count;
+
+    // Items collected between BeginBulkLoad() and EndBulkLoad()
+    bool                                              m_bulkLoading;
+    std::vector<std::pair<ee_rtree::Rect, SCH_ITEM*>> m_pending;
+};
+
+
+/**
+ * Bulk load an #EE_RTREE until Finish() is called or the loader goes out of scope, so that the
+ * collected items are indexed (and freed with the tree) even if loading throws.
+ */
+class EE_RTREE_BULK_LOADER
+{
+public:
+    EE_RTREE_BULK_LOADER( EE_RTREE& aTree ) :
+            m_tree( aTree ),
+            m_finished( false )
+    {
+        m_tree.BeginBulkLoad();
+    }
+
+    ~EE_RTREE_BULK_LOADER()
+    {
+        Finish();
+    }
+
+    void Finish()
+    {
+        if( !m_finished )
+            m_tree.EndBulkLoad();
+
+        m_finished = true;
+    }
+
+private:
+    EE_RTREE& m_tree;
+    bool      m_finished;
 };
 
 
@@ -31,6 +31,7 @@
 
 #include <wx/filefn.h>
 
+#include <core/wx_stl_compat.h>
 #include <eda_item.h>
 #include <eda_rect.h>
 #include <id.h>
@@ -58,6 +59,8 @@
 #include <tool/common_tools.h>
 
 #include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
 // TODO(JE) Debugging only
 #include <profile.h>
@@ -973,13 +976,159 @@ void SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath,
                                    std::function<void( SCH_ITEM* )>* aChangedHandler ) const
 {
     std::vector<DANGLING_END_ITEM> endPoints;
+    std::vector<size_t>            firstEndPoint;   // Index of each item's first end point
 
     for( SCH_ITEM* item : Items() )
+    {
+        firstEndPoint.push_back( endPoints.size() );
         item->GetEndPoints( endPoints );
+    }
+
+    firstEndPoint.push_back( endPoints.size() );
+
+    // Lines are stored as a start/end pair, and the UpdateDanglingState() implementations
+    // rely on seeing both entries of a pair, in that order.
+    auto isSegmentStart =
+            []( DANGLING_END_T aType )
+            {
+                return aType == WIRE_START_END || aType == BUS_START_END
+                        || aType == GRAPHIC_START_END;
+            };
+
+    auto isSegmentEnd =
+            []( DANGLING_END_T aType )
+            {
+                return aType == WIRE_END_END || aType == BUS_END_END || aType == GRAPHIC_END_END;
+            };
+
+    // End points indexed by position, for the exact position matches
+    std::unordered_map<wxPoint, std::vector<size_t>> endPointsAt;
+
+    // Segments bucketed in a uniform grid, for the items (labels, bus entries) that connect
+    // anywhere along a wire or bus.  The cell size is the mean segment extent so that each
+    // segment only lands in a few cells.
+    std::vector<size_t> segments;
+    int64_t             totalExtent = 0;
+
+    for( size_t ii = 0; ii < endPoints.size(); ii++ )
+    {
+        endPointsAt[ endPoints[ii].GetPosition() ].push_back( ii );
+
+        if( isSegmentStart( endPoints[ii].GetType() ) && ii + 1 < endPoints.size() )
+        {
+            wxPoint delta = endPoints[ii + 1].GetPosition() - endPoints[ii].GetPosition();
+
+            segments.push_back( ii );
+            totalExtent += std::max( std::abs( delta.x ), std::abs( delta.y ) );
+        }
+    }
+
+    int64_t cellSize = std::max<int64_t>( 1, segments.empty() ? 1
+                                                              : totalExtent / segments.size() );
+
+    auto cellOf =
+            [cellSize]( int aCoord ) -> int
+            {
+                int64_t coord = aCoord;
+                return int( coord >= 0 ? coord / cellSize : ( coord - cellSize + 1 ) / cellSize );
+            };
+
+    std::unordered_map<wxPoint, std::vector<size_t>> segmentsInCell;
+
+    // Add each segment only to the cells it crosses, not to every cell of its bounding box, so
+    // that long diagonal wires and buses don't flood the grid.  The segment is walked one cell
+    // column at a time (one cell row for steep segments) and added to the cells covering its
+    // extent within that column.
+    for( size_t start : segments )
+    {
+        wxPoint a = endPoints[start].GetPosition();
+        wxPoint b = endPoints[start + 1].GetPosition();
+        bool    steep = std::abs( b.y - a.y ) > std::abs( b.x - a.x );
+
+        if( steep )
+        {
+            std::swap( a.x, a.y );
+            std::swap( b.x, b.y );
+        }
+
+        if( a.x > b.x )
+            std::swap( a, b );
+
+        double slope = ( b.x == a.x ) ? 0.0 : double( b.y - a.y ) / ( b.x - a.x );
+
+        // Inflate by 1 to cover the accuracy used by the segment hit tests
+        for( int col = cellOf( a.x - 1 ); col <= cellOf( b.x + 1 ); col++ )
+        {
+            int64_t x0 = std::max<int64_t>( col * cellSize, a.x );
+            int64_t x1 = std::min<int64_t>( ( col + 1 ) * cellSize - 1, b.x );
+
+            x0 = std::min<int64_t>( x0, b.x );
+            x1 = std::max<int64_t>( x1, a.x );
+
+            double y0 = a.y + ( x0 - a.x ) * slope;
+            double y1 = a.y + ( x1 - a.x ) * slope;
+            int    minRow = cellOf( int( std::floor( std::min( y0, y1 ) ) ) - 1 );
+            int    maxRow = cellOf( int( std::ceil( std::max( y0, y1 ) ) ) + 1 );
+
+            for( int row = minRow; row <= maxRow; row++ )
+            {
+                wxPoint cell = steep ? wxPoint( row, col ) : wxPoint( col, row );
+                segmentsInCell[ cell ].push_back( start );
+            }
+        }
+    }
+
+    std::vector<size_t>            candidates;
+    std::vector<DANGLING_END_ITEM> itemEndPoints;
+    size_t                         itemIdx = 0;
 
     for( SCH_ITEM* item : Items() )
     {
-        if( item->UpdateDanglingState( endPoints, aPath ) )
+        candidates.clear();
+
+        // Gather the end points which can possibly touch one of this item's own end points
+        for( size_t ii = firstEndPoint[itemIdx]; ii < firstEndPoint[itemIdx + 1]; ii++ )
+        {
+            const wxPoint& pos = endPoints[ii].GetPosition();
+
+            for( size_t match : endPointsAt[ pos ] )
+            {
+                DANGLING_END_T type = endPoints[match].GetType();
+
+                if( isSegmentEnd( type ) && match > 0 )
+                    candidates.push_back( match - 1 );
+
+                candidates.push_back( match );
+
+                if( isSegmentStart( type ) && match + 1 < endPoints.size() )
+                    candidates.push_back( match + 1 );
+            }
+
+            auto cell = segmentsInCell.find( wxPoint( cellOf( pos.x ), cellOf( pos.y ) ) );
+
+            if( cell != segmentsInCell.end() )
+            {
+                for( size_t start : cell->second )
+                {
+                    candidates.push_back( start );
+                    candidates.push_back( start + 1 );
+                }
+            }
+        }
+
+        itemIdx++;
+
+        // Keep the original list order so that the result is the same as testing against
+        // all end points
+        std::sort( candidates.begin(), candidates.end() );
+        candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+        itemEndPoints.clear();
+
+        for( size_t ii : candidates )
+            itemEndPoints.push_back( endPoints[ii] );
+
+        if( item->UpdateDanglingState( itemEndPoints, aPath ) )
         {
             if( aChangedHandler )
                 (*aChangedHandler)( item );
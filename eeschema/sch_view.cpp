@@ -91,6 +91,8 @@ void SCH_VIEW::ResizeSheetWorkingArea( const SCH_SCREEN* aScreen )
 
 void SCH_VIEW::DisplaySheet( const SCH_SCREEN *aScreen )
 {
+    BeginBulkLoad();
+
     for( SCH_ITEM* item : aScreen->Items() )
         Add( item );
 
@@ -114,6 +116,8 @@ void SCH_VIEW::DisplaySheet( const SCH_SCREEN *aScreen )
 
     Add( m_drawingSheet.get() );
 
+    EndBulkLoad();
+
     InitPreview();
 }
 
@@ -189,6 +189,14 @@ public:
      */
     bool m_HideVersionFromTitle;
 
+    /**
+     * Maximum number of item copies held by the board editor undo list.  This is a count of
+     * items (a footprint counts for itself and each of its children), not of bytes.  The oldest
+     * undo commands are dropped once the budget is exceeded; the most recent command is always
+     * kept.  0 means no limit.
+     */
+    int m_UndoItemBudget;
+
 private:
     ADVANCED_CFG();
 
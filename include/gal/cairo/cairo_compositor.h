@@ -77,6 +77,31 @@ public:
     /// @copydoc COMPOSITOR::Present()
     virtual void Present() override;
 
+    /**
+     * Write the pending drawing operations of a buffer to its pixels.
+     *
+     * Must be called before DrawBufferRows() reads the buffer.
+     *
+     * @param aBufferHandle is the buffer to flush.
+     */
+    void FlushBuffer( unsigned int aBufferHandle );
+
+    /**
+     * Composite a band of rows of a buffer onto a bitmap of the same size as the buffers.
+     *
+     * Unlike DrawBuffer(), this does not use any Cairo context, so disjoint bands of the same
+     * bitmap can be composited from several threads at once.  The buffer pixels are read
+     * directly, so it must have been flushed with FlushBuffer() first.
+     *
+     * @param aBufferHandle is the buffer to composite.
+     * @param aTarget is the first row of the target bitmap (ARGB32, premultiplied alpha).
+     * @param aTargetStride is the size of a target bitmap row, in bytes.
+     * @param aTop is the first row of the band.
+     * @param aBottom is the row following the last row of the band.
+     */
+    void DrawBufferRows( unsigned int aBufferHandle, unsigned char* aTarget,
+                         unsigned int aTargetStride, unsigned int aTop, unsigned int aBottom );
+
     void SetAntialiasingMode( CAIRO_ANTIALIASING_MODE aMode ); // clears all buffers
     CAIRO_ANTIALIASING_MODE GetAntialiasingMode() const
     {
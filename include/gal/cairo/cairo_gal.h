@@ -478,6 +478,9 @@ protected:
     bool                m_isInitialized;       ///< Are Cairo image & surface ready to use
     COLOR4D             m_backgroundColor;     ///< Background color
     wxCursor            m_currentwxCursor;     ///< wxCursor showing the current native cursor
+
+    /// Number of screen rows composited by one thread at a time in endDrawing()
+    static constexpr unsigned COMPOSITE_BAND_HEIGHT = 64;
 };
 
 } // namespace KIGFX
@@ -117,6 +117,8 @@ public:
 
     wxString AsString() const;
 
+    size_t Hash() const;
+
     bool operator==( KIID_PATH const& rhs ) const
     {
         if( size() != rhs.size() )
@@ -149,4 +151,14 @@ public:
     }
 };
 
+
+/// Hash function for KIID_PATH, to index unordered containers by path
+struct KIID_PATH_HASH
+{
+    size_t operator()( const KIID_PATH& aPath ) const
+    {
+        return aPath.Hash();
+    }
+};
+
 #endif // KIID_H
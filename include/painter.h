@@ -95,6 +95,19 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Draw a simplified version of an item, for the aggregated drawings used by the #VIEW
+     * when zoomed out (see VIEW::SetLODThreshold()).
+     *
+     * @param aItem is an item to be drawn.
+     * @param aLayer is the layer being rendered.
+     * @return false if there is no simplified version of the item, to draw it with Draw().
+     */
+    virtual bool DrawLOD( const VIEW_ITEM* aItem, int aLayer )
+    {
+        return false;
+    }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
@@ -28,6 +28,7 @@
 #define __VIEW_H
 
 #include <vector>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <memory>
@@ -378,6 +379,20 @@ public:
      */
     void Clear();
 
+    /**
+     * Start collecting the items passed to Add() instead of indexing them one by one.
+     *
+     * Use this when adding a whole document.  Only Add() and Remove() may be called until
+     * EndBulkLoad().
+     */
+    void BeginBulkLoad();
+
+    /**
+     * Index the items added since BeginBulkLoad().  The empty layer trees are packed at once,
+     * which is much faster than inserting the items one by one and gives faster queries.
+     */
+    void EndBulkLoad();
+
     /**
      * Control the visibility of a particular layer.
      *
@@ -393,6 +408,9 @@ public:
             // Target has to be redrawn after changing its visibility
             MarkTargetDirty( m_layers[aLayer].target );
             m_layers[aLayer].visible = aVisible;
+
+            // Item visibility may depend on other layers (see VIEW_ITEM::ViewGetLOD())
+            invalidateLOD();
         }
     }
 
@@ -415,6 +433,30 @@ public:
         m_layers[aLayer].displayOnly = aDisplayOnly;
     }
 
+    /**
+     * Set if a cached layer is drawn from aggregated drawings of its items when the view is
+     * zoomed out below the threshold set with SetLODThreshold().
+     */
+    inline void SetLayerAggregated( int aLayer, bool aAggregated = true )
+    {
+        wxCHECK( aLayer < (int) m_layers.size(), /*void*/ );
+        m_layers[aLayer].aggregated = aAggregated;
+        invalidateLOD();
+    }
+
+    /**
+     * Set the aggregated level of detail used to draw large views when zoomed out.
+     *
+     * Below \a aScale, the items of the aggregated layers are not drawn one by one: the view
+     * is split into square tiles, and the simplified drawings of the items of a tile (see
+     * PAINTER::DrawLOD()) are cached in a single group per layer.  Only the tiles containing
+     * modified items are rebuilt.
+     *
+     * @param aScale is the scale below which aggregated drawings are used, 0 to disable them.
+     * @param aTileSize is the size of the tiles, in world units.
+     */
+    void SetLODThreshold( double aScale, int aTileSize );
+
     /**
      * Change the rendering target for a particular layer.
      *
@@ -524,6 +566,10 @@ public:
 
     /**
      * Rebuild GAL display lists.
+     *
+     * The lists are rebuilt by the next UpdateItems() call.  Only the geometry the items
+     * cache for themselves (see VIEW_ITEM::ViewPrepareDraw()) is computed on several cores;
+     * the GAL is not thread safe, so painting the items into their groups stays serial.
      */
     void RecacheAllItems();
 
@@ -608,6 +654,9 @@ public:
 
     /**
      * Iterate through the list of items that asked for updating and updates them.
+     *
+     * The geometry of the items to redraw is prepared in parallel (see
+     * VIEW_ITEM::ViewPrepareDraw()) before they are drawn to the GAL.
      */
     void UpdateItems();
 
@@ -690,6 +739,16 @@ protected:
         RENDER_TARGET           target;          ///< Where the layer should be rendered.
         std::set<int>           requiredLayers;  ///< Layers that have to be enabled to show
                                                  ///< the layer.
+        bool                    aggregated;      ///< Is the layer drawn from aggregated
+                                                 ///< drawings when zoomed out?
+    };
+
+    ///< Aggregated drawings of the items located in a tile of the view.
+    struct LOD_TILE
+    {
+        std::map<int, int> groups;  ///< GAL group of every aggregated layer (layer id -> group)
+        BOX2I              bbox;    ///< Bounding box of the items of the tile
+        bool               dirty = true;
     };
 
 
@@ -757,6 +816,28 @@ protected:
     ///< Update all information needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    ///< Call VIEW_ITEM::ViewPrepareDraw() for the items to redraw, using all available cores
+    ///< when there are enough of them.  The GAL groups are still built serially afterwards.
+    void prepareItems( const std::vector<VIEW_ITEM*>& aItems );
+
+    ///< Check if the aggregated drawings are used to draw a layer at the current scale
+    bool useLOD( const VIEW_LAYER& aLayer ) const;
+
+    ///< Mark the tiles containing an item, at its previous and current location, as dirty
+    void markLODDirty( VIEW_ITEM* aItem );
+
+    ///< Mark all of the aggregated drawings as dirty
+    void invalidateLOD();
+
+    ///< Discard the aggregated drawings and the tiles
+    void clearLOD();
+
+    ///< Rebuild the dirty aggregated drawings, if the current scale uses them
+    void updateLOD();
+
+    ///< Draw the aggregated drawings of a layer intersecting aRect
+    void drawLOD( const VIEW_LAYER& aLayer, const BOX2I& aRect );
+
     ///< Update bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
@@ -842,6 +923,21 @@ protected:
 
     ///< Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
+
+    ///< Scale below which the aggregated layers are drawn from m_lodTiles (0 if disabled).
+    double m_lodScale;
+
+    ///< Size of the LOD tiles, in world units.
+    int m_lodTileSize;
+
+    ///< Aggregated drawings, indexed by tile coordinates.
+    std::map<std::pair<int, int>, LOD_TILE> m_lodTiles;
+
+    ///< False if the tiles have to be built from scratch.
+    bool m_lodValid;
+
+    ///< True if any tile has to be rebuilt.
+    bool m_lodDirty;
 };
 } // namespace KIGFX
 
@@ -111,6 +111,17 @@ public:
     virtual void ViewDraw( int aLayer, VIEW* aView ) const
     {}
 
+    /**
+     * Build and cache the geometry the item needs to be drawn (shape polygons, triangulations,
+     * etc.).
+     *
+     * Called before the item is redrawn on its cached layers, concurrently for several items,
+     * so that the expensive computations do not run serially when the item is drawn.  It must
+     * not modify anything shared with other items.
+     */
+    virtual void ViewPrepareDraw()
+    {}
+
     /**
      * Return the all the layers within the VIEW the object is painted on.
      *
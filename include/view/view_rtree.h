@@ -31,6 +31,9 @@
 
 #include <geometry/rtree.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace KIGFX
 {
 typedef RTree<VIEW_ITEM*, int, 2, double> VIEW_RTREE_BASE;
@@ -52,7 +55,10 @@ public:
         const int       mmin[2] = { bbox.GetX(), bbox.GetY() };
         const int       mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
 
-        VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
+        if( m_bulkLoading )
+            m_pending.emplace_back( Rect{ { mmin[0], mmin[1] }, { mmax[0], mmax[1] } }, aItem );
+        else
+            VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
     }
 
     /**
@@ -62,6 +68,16 @@ public:
      */
     void Remove( VIEW_ITEM* aItem )
     {
+        if( m_bulkLoading )
+        {
+            m_pending.erase( std::remove_if( m_pending.begin(), m_pending.end(),
+                                             [aItem]( const std::pair<Rect, VIEW_ITEM*>& aEntry )
+                                             {
+                                                 return aEntry.second == aItem;
+                                             } ),
+                             m_pending.end() );
+        }
+
         // const BOX2I&    bbox    = aItem->ViewBBox();
 
         // FIXME: use cached bbox or ptr_map to speed up pointer <-> node lookups.
@@ -71,6 +87,50 @@ public:
         VIEW_RTREE_BASE::Remove( mmin, mmax, aItem );
     }
 
+    /**
+     * Remove all items from the tree, including the ones collected since BeginBulkLoad().
+     */
+    void RemoveAll()
+    {
+        VIEW_RTREE_BASE::RemoveAll();
+        m_pending.clear();
+    }
+
+    /**
+     * Start collecting the items passed to Insert() instead of inserting them one by one.
+     *
+     * The collected items are not found by Query() until EndBulkLoad() has been called.
+     */
+    void BeginBulkLoad()
+    {
+        m_bulkLoading = true;
+    }
+
+    /**
+     * Add the items collected since BeginBulkLoad() to the tree.  An empty tree is packed from
+     * them at once, which is much faster than inserting them one by one.
+     */
+    void EndBulkLoad()
+    {
+        m_bulkLoading = false;
+
+        if( m_pending.empty() )
+            return;
+
+        if( begin() == end() )
+        {
+            BulkLoad( m_pending );
+        }
+        else
+        {
+            for( const std::pair<Rect, VIEW_ITEM*>& entry : m_pending )
+                VIEW_RTREE_BASE::Insert( entry.first.m_min, entry.first.m_max, entry.second );
+        }
+
+        m_pending.clear();
+        m_pending.shrink_to_fit();
+    }
+
     /**
      * Execute a function object \a aVisitor for each item whose bounding box intersects
      * with \a aBounds.
@@ -98,6 +158,9 @@ public:
     }
 
 private:
+    // Items collected between BeginBulkLoad() and EndBulkLoad()
+    bool                                     m_bulkLoading = false;
+    std::vector<std::pair<Rect, VIEW_ITEM*>> m_pending;
 };
 } // namespace KIGFX
 
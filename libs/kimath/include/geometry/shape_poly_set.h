@@ -497,7 +497,20 @@ public:
 
     SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& aOther );
 
-    void CacheTriangulation( bool aPartition = true );
+    /**
+     * Build (or update) the cached triangulation of the polygon set.
+     *
+     * Each polygon is triangulated independently.  The triangles of polygons which did not
+     * change since the previous call are reused, so updating the cache only costs the polygons
+     * that were modified.
+     *
+     * @param aPartition true to split the polygons into a regular grid of cells before
+     *                   triangulating, which gives smaller triangle bounding boxes.
+     * @param aAllowThreads true to spread the polygons over several threads when there are
+     *                      enough points to triangulate.  Callers which already run in a
+     *                      worker thread should leave this false.
+     */
+    void CacheTriangulation( bool aPartition = true, bool aAllowThreads = false );
     bool IsTriangulationUpToDate() const;
 
     MD5_HASH GetHash() const;
@@ -1025,6 +1038,19 @@ public:
     ///< For \a aFastMode meaning, see function booleanOp
     void Simplify( POLYGON_MODE aFastMode );
 
+    /**
+     * Simplify the polyset using a divide-and-conquer union spread over several threads.
+     *
+     * The polygons are sorted by position, split into contiguous subsets which are simplified
+     * concurrently, and the partial results are then merged pairwise in a reduction tree.  The
+     * resulting area is the same as Simplify().  Sets which are too small to benefit, or which
+     * contain arcs, are simplified serially.
+     *
+     * @param aFastMode see function booleanOp.
+     * @param aThreadCount is the maximum number of threads to use (0 for all available cores).
+     */
+    void ParallelSimplify( POLYGON_MODE aFastMode, size_t aThreadCount = 0 );
+
     /**
      * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s).
      *
@@ -1369,6 +1395,20 @@ private:
     void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
                     const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
 
+    /**
+     * Move the polygons of the set into at most \a aThreadCount subsets of spatially
+     * neighbouring polygons, for use by the parallel boolean operations.
+     *
+     * @return the subsets, or an empty list if the set is too small to be worth splitting.
+     */
+    std::vector<SHAPE_POLY_SET> splitForParallelOp( size_t aThreadCount );
+
+    /**
+     * Union the (already simplified) subsets concurrently in a reduction tree and store the
+     * result in this set.
+     */
+    void mergeParallel( std::vector<SHAPE_POLY_SET>& aSubsets, POLYGON_MODE aFastMode );
+
     /**
      * Check whether the point \a aP is inside the \a aSubpolyIndex-th polygon of the polyset. If
      * the points lies on an edge, the polygon is considered to contain it.
@@ -1418,6 +1458,16 @@ private:
 
     MD5_HASH checksum() const;
 
+    ///< Return a fast (non cryptographic) hash of each polygon, used to detect which polygons
+    ///< changed since the triangulation was cached.  The points are hashed relative to
+    ///< m_triangulationOffset.
+    std::vector<size_t> polygonHashes() const;
+    static size_t polygonHash( const POLYGON& aPoly, const VECTOR2I& aOffset );
+
+    ///< Triangulate a single polygon (outline and holes), appending the result to \a aResult.
+    static void triangulateSingle( const POLYGON& aPoly, bool aPartition,
+                                   std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>& aResult );
+
 private:
     typedef std::vector<POLYGON> POLYSET;
 
@@ -1425,8 +1475,16 @@ private:
 
     std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
 
+    ///< For each polygon of the set, the hash it had when it was triangulated and the number
+    ///< of consecutive entries of m_triangulatedPolys built from it.
+    std::vector<size_t> m_triangulationHashes;
+    std::vector<size_t> m_triangulationSizes;
+
+    ///< Translation applied by Move() since the hashes were computed, so that moving the set
+    ///< does not need to hash it again.
+    VECTOR2I m_triangulationOffset;
+
     bool     m_triangulationValid = false;
-    MD5_HASH m_hash;
 };
 
 #endif // __SHAPE_POLY_SET_H
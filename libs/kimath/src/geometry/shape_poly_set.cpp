@@ -31,16 +31,22 @@
 #include <assert.h>                          // for assert
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <future>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <map>
 #include <memory>
 #include <set>
 #include <string>                            // for char_traits, operator!=
+#include <thread>
 #include <type_traits>                       // for swap, move
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <atomic>
+#include <boost/functional/hash.hpp>
+
 #include <clipper.hpp>                       // for Clipper, PolyNode, Clipp...
 #include <geometry/geometry_utils.h>
 #include <geometry/polygon_triangulation.h>
@@ -81,13 +87,14 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
             m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>( *poly ) );
         }
 
-        m_hash = aOther.GetHash();
+        m_triangulationHashes = aOther.m_triangulationHashes;
+        m_triangulationSizes = aOther.m_triangulationSizes;
+        m_triangulationOffset = aOther.m_triangulationOffset;
         m_triangulationValid = true;
     }
     else
     {
         m_triangulationValid = false;
-        m_hash = MD5_HASH();
         m_triangulatedPolys.clear();
     }
 }
@@ -717,6 +724,117 @@ void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& a, const SHAPE_P
 }
 
 
+// Below this number of polygons per thread, splitting the set costs more than running the
+// boolean engine on several threads gains.
+static const size_t PARALLEL_OP_MIN_POLYS_PER_THREAD = 64;
+
+
+std::vector<SHAPE_POLY_SET> SHAPE_POLY_SET::splitForParallelOp( size_t aThreadCount )
+{
+    std::vector<SHAPE_POLY_SET> subsets;
+
+    if( aThreadCount == 0 )
+        aThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+
+    size_t subsetCount = std::min( aThreadCount,
+                                   m_polys.size() / PARALLEL_OP_MIN_POLYS_PER_THREAD );
+
+    if( subsetCount < 2 || ArcCount() > 0 )
+        return subsets;
+
+    // Sort the polygons along X so that each subset covers a narrow band of the set.  Polygons
+    // from different bands rarely overlap, which keeps the merges in the reduction tree cheap.
+    std::vector<std::pair<int, size_t>> order;
+    order.reserve( m_polys.size() );
+
+    for( size_t ii = 0; ii < m_polys.size(); ++ii )
+        order.emplace_back( m_polys[ii][0].BBox().Centre().x, ii );
+
+    std::sort( order.begin(), order.end() );
+
+    subsets.resize( subsetCount );
+
+    for( size_t ii = 0; ii < order.size(); ++ii )
+    {
+        SHAPE_POLY_SET& subset = subsets[ ii * subsetCount / order.size() ];
+        subset.m_polys.push_back( std::move( m_polys[ order[ii].second ] ) );
+    }
+
+    m_polys.clear();
+
+    return subsets;
+}
+
+
+void SHAPE_POLY_SET::mergeParallel( std::vector<SHAPE_POLY_SET>& aSubsets,
+                                    POLYGON_MODE aFastMode )
+{
+    while( aSubsets.size() > 1 )
+    {
+        size_t pairCount = aSubsets.size() / 2;
+
+        auto merge_lambda =
+                [&aSubsets, aFastMode]( size_t aPair )
+                {
+                    aSubsets[ 2 * aPair ].BooleanAdd( aSubsets[ 2 * aPair + 1 ], aFastMode );
+                };
+
+        if( pairCount == 1 )
+        {
+            merge_lambda( 0 );
+        }
+        else
+        {
+            std::vector<std::future<void>> returns( pairCount );
+
+            for( size_t ii = 0; ii < pairCount; ++ii )
+                returns[ii] = std::async( std::launch::async, merge_lambda, ii );
+
+            for( std::future<void>& ret : returns )
+                ret.wait();
+        }
+
+        // Compact the merged results (and an unpaired trailing subset) for the next level
+        size_t remaining = 0;
+
+        for( size_t ii = 0; ii < aSubsets.size(); ii += 2 )
+            std::swap( aSubsets[ remaining++ ].m_polys, aSubsets[ii].m_polys );
+
+        aSubsets.resize( remaining );
+    }
+
+    m_polys = std::move( aSubsets[0].m_polys );
+}
+
+
+void SHAPE_POLY_SET::ParallelSimplify( POLYGON_MODE aFastMode, size_t aThreadCount )
+{
+    std::vector<SHAPE_POLY_SET> subsets = splitForParallelOp( aThreadCount );
+
+    if( subsets.empty() )
+    {
+        Simplify( aFastMode );
+        return;
+    }
+
+    std::vector<std::future<void>> returns( subsets.size() );
+
+    for( size_t ii = 0; ii < subsets.size(); ++ii )
+    {
+        returns[ii] = std::async( std::launch::async,
+                                  [&subsets, ii, aFastMode]()
+                                  {
+                                      subsets[ii].Simplify( aFastMode );
+                                  } );
+    }
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
+
+    mergeParallel( subsets, aFastMode );
+}
+
+
 void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, int aCircleSegmentsCount,
                                              POLYGON_MODE aFastMode )
 {
@@ -1802,10 +1920,13 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
             path.Move( aVector );
     }
 
+    // The hashes are relative to m_triangulationOffset, so moving the triangles along and
+    // shifting the offset keeps them valid without hashing the set.  Triangles which were
+    // already stale stay stale: their hashes still don't match.
     for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
         tri->Move( aVector );
 
-    m_hash = checksum();
+    m_triangulationOffset += aVector;
 }
 
 
@@ -2187,6 +2308,8 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
     static_cast<SHAPE&>(*this) = aOther;
     m_polys = aOther.m_polys;
     m_triangulatedPolys.clear();
+    m_triangulationHashes.clear();
+    m_triangulationSizes.clear();
     m_triangulationValid = false;
 
     if( aOther.IsTriangulationUpToDate() )
@@ -2197,7 +2320,9 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
             m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>( *poly ) );
         }
 
-        m_hash = aOther.GetHash();
+        m_triangulationHashes = aOther.m_triangulationHashes;
+        m_triangulationSizes = aOther.m_triangulationSizes;
+        m_triangulationOffset = aOther.m_triangulationOffset;
         m_triangulationValid = true;
     }
 
@@ -2206,24 +2331,25 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
 
 MD5_HASH SHAPE_POLY_SET::GetHash() const
 {
-    if( !m_hash.IsValid() )
-        return checksum();
-
-    return m_hash;
+    return checksum();
 }
 
 
 bool SHAPE_POLY_SET::IsTriangulationUpToDate() const
 {
-    if( !m_triangulationValid )
-        return false;
-
-    if( !m_hash.IsValid() )
+    if( !m_triangulationValid || m_polys.size() != m_triangulationHashes.size() )
         return false;
 
-    MD5_HASH hash = checksum();
+    // The polygons can be modified through the references handed out by Outline(), Hole(),
+    // Polygon() and the vertex iterators, so there is no way to track changes as they are made.
+    // Hash the polygons, stopping at the first one which changed.
+    for( size_t ii = 0; ii < m_polys.size(); ++ii )
+    {
+        if( polygonHash( m_polys[ii], m_triangulationOffset ) != m_triangulationHashes[ii] )
+            return false;
+    }
 
-    return hash == m_hash;
+    return true;
 }
 
 
@@ -2297,69 +2423,185 @@ static void partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aPoly, int a
 }
 
 
-void SHAPE_POLY_SET::CacheTriangulation( bool aPartition )
+void SHAPE_POLY_SET::triangulateSingle( const POLYGON& aPoly, bool aPartition,
+                                        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>& aResult )
 {
-    bool recalculate = !m_hash.IsValid();
-    MD5_HASH hash;
-
-    if( !m_triangulationValid )
-        recalculate = true;
-
-    if( !recalculate )
-    {
-        hash = checksum();
-
-        if( m_hash != hash )
-        {
-            m_hash = hash;
-            recalculate = true;
-        }
-    }
-
-    if( !recalculate )
-        return;
-
     SHAPE_POLY_SET tmpSet;
 
     if( aPartition )
     {
         // This partitions into regularly-sized grids (1cm in pcbnew)
-        SHAPE_POLY_SET flattened( *this );
+        SHAPE_POLY_SET flattened;
+        flattened.m_polys.push_back( aPoly );
         flattened.ClearArcs();
         partitionPolyIntoRegularCellGrid( flattened, 1e7, tmpSet );
     }
     else
     {
-        tmpSet = *this;
+        tmpSet.m_polys.push_back( aPoly );
 
         if( tmpSet.HasHoles() )
             tmpSet.Fracture( PM_FAST );
     }
 
-    m_triangulatedPolys.clear();
-    m_triangulationValid = false;
-
     while( tmpSet.OutlineCount() > 0 )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        PolygonTriangulation tess( *m_triangulatedPolys.back() );
+        aResult.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
+        PolygonTriangulation tess( *aResult.back() );
 
         // If the tesselation fails, we re-fracture the polygon, which will
         // first simplify the system before fracturing and removing the holes
         // This may result in multiple, disjoint polygons.
         if( !tess.TesselatePolygon( tmpSet.Polygon( 0 ).front() ) )
         {
+            aResult.pop_back();
             tmpSet.Fracture( PM_FAST );
-            m_triangulationValid = false;
             continue;
         }
 
         tmpSet.DeletePolygon( 0 );
-        m_triangulationValid = true;
     }
+}
 
-    if( m_triangulationValid )
-        m_hash = checksum();
+
+void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aAllowThreads )
+{
+    // Below this number of points per thread, starting the thread costs more than it saves
+    const size_t minPointsPerThread = 5000;
+
+    std::vector<size_t> hashes = polygonHashes();
+
+    if( m_triangulationValid && hashes == m_triangulationHashes )
+        return;
+
+    typedef std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> TRI_LIST;
+
+    // Index the previous triangulation by polygon hash, so that the polygons which did not
+    // change can keep their triangles
+    std::unordered_multimap<size_t, TRI_LIST> previous;
+    size_t                                    offset = 0;
+
+    for( size_t ii = 0; ii < m_triangulationHashes.size(); ++ii )
+    {
+        TRI_LIST tris;
+
+        for( size_t jj = 0; jj < m_triangulationSizes[ii]; ++jj )
+            tris.push_back( std::move( m_triangulatedPolys[ offset++ ] ) );
+
+        previous.emplace( m_triangulationHashes[ii], std::move( tris ) );
+    }
+
+    std::vector<TRI_LIST> polyTris( m_polys.size() );
+    std::vector<size_t>   dirty;
+
+    for( size_t ii = 0; ii < m_polys.size(); ++ii )
+    {
+        auto it = previous.find( hashes[ii] );
+
+        if( it != previous.end() )
+        {
+            polyTris[ii] = std::move( it->second );
+            previous.erase( it );
+        }
+        else
+        {
+            dirty.push_back( ii );
+        }
+    }
+
+    std::atomic<size_t> nextItem( 0 );
+
+    auto tri_lambda =
+            [&]() -> size_t
+            {
+                size_t num = 0;
+
+                for( size_t i = nextItem.fetch_add( 1 ); i < dirty.size();
+                     i = nextItem.fetch_add( 1 ) )
+                {
+                    triangulateSingle( m_polys[ dirty[i] ], aPartition, polyTris[ dirty[i] ] );
+                    num++;
+                }
+
+                return num;
+            };
+
+    size_t parallelThreadCount = 1;
+
+    if( aAllowThreads && dirty.size() > 1 )
+    {
+        size_t pointCount = 0;
+
+        for( size_t ii : dirty )
+        {
+            for( const SHAPE_LINE_CHAIN& lc : m_polys[ii] )
+                pointCount += lc.PointCount();
+        }
+
+        parallelThreadCount = std::min<size_t>( { std::thread::hardware_concurrency(),
+                                                  dirty.size(),
+                                                  pointCount / minPointsPerThread } );
+    }
+
+    if( parallelThreadCount <= 1 )
+    {
+        tri_lambda();
+    }
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, tri_lambda );
+
+        for( std::future<size_t>& ret : returns )
+            ret.wait();
+    }
+
+    m_triangulatedPolys.clear();
+    m_triangulationSizes.clear();
+
+    for( TRI_LIST& tris : polyTris )
+    {
+        m_triangulationSizes.push_back( tris.size() );
+
+        for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : tris )
+            m_triangulatedPolys.push_back( std::move( tri ) );
+    }
+
+    m_triangulationHashes = std::move( hashes );
+    m_triangulationValid = !m_triangulatedPolys.empty();
+}
+
+
+std::vector<size_t> SHAPE_POLY_SET::polygonHashes() const
+{
+    std::vector<size_t> hashes;
+    hashes.reserve( m_polys.size() );
+
+    for( const POLYGON& poly : m_polys )
+        hashes.push_back( polygonHash( poly, m_triangulationOffset ) );
+
+    return hashes;
+}
+
+
+size_t SHAPE_POLY_SET::polygonHash( const POLYGON& aPoly, const VECTOR2I& aOffset )
+{
+    size_t hash = aPoly.size();
+
+    for( const SHAPE_LINE_CHAIN& lc : aPoly )
+    {
+        boost::hash_combine( hash, lc.PointCount() );
+
+        for( const VECTOR2I& pt : lc.CPoints() )
+        {
+            boost::hash_combine( hash, pt.x - aOffset.x );
+            boost::hash_combine( hash, pt.y - aOffset.y );
+        }
+    }
+
+    return hash;
 }
 
 
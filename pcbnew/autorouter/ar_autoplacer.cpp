@@ -39,7 +39,10 @@
 
 #include "ar_autoplacer.h"
 #include "ar_matrix.h"
+#include <atomic>
+#include <future>
 #include <memory>
+#include <thread>
 #include <ratsnest/ratsnest_data.h>
 
 #define AR_GAIN            16
@@ -88,6 +91,8 @@ AR_AUTOPLACER::AR_AUTOPLACER( BOARD* aBoard )
     m_progressReporter = nullptr;
     m_refreshCallback = nullptr;
     m_minCost = 0.0;
+    m_placementMapValid = false;
+    m_wordsPerRow = 0;
 }
 
 
@@ -105,6 +110,7 @@ void AR_AUTOPLACER::placeFootprint( FOOTPRINT* aFootprint, bool aDoNotRecreateRa
 int AR_AUTOPLACER::genPlacementRoutingMatrix()
 {
     m_matrix.UnInitRoutingMatrix();
+    m_placementMapValid = false;
 
     EDA_RECT bbox = m_board->GetBoardEdgesBoundingBox();
 
@@ -366,6 +372,8 @@ void AR_AUTOPLACER::buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance )
 
 void AR_AUTOPLACER::genModuleOnRoutingMatrix( FOOTPRINT* Module )
 {
+    m_placementMapValid = false;
+
     int         ox, oy, fx, fy;
     LSET        layerMask;
     EDA_RECT    fpBBox = Module->GetBoundingBox();
@@ -429,58 +437,145 @@ void AR_AUTOPLACER::genModuleOnRoutingMatrix( FOOTPRINT* Module )
 }
 
 
+void AR_AUTOPLACER::buildPlacementMap()
+{
+    int rows = m_matrix.m_Nrows;
+    int cols = m_matrix.m_Ncols;
+
+    m_wordsPerRow = ( cols + 63 ) / 64;
+
+    for( int side = 0; side < AR_MAX_ROUTING_LAYERS_COUNT; side++ )
+    {
+        m_zoneCells[side].clear();
+        m_footprintCells[side].clear();
+        m_keepOutSums[side].clear();
+
+        if( !m_matrix.m_BoardSide[side] || !m_matrix.m_DistSide[side] )
+            continue;
+
+        m_zoneCells[side].resize( (size_t) rows * m_wordsPerRow, 0 );
+        m_footprintCells[side].resize( (size_t) rows * m_wordsPerRow, 0 );
+        m_keepOutSums[side].resize( (size_t) ( rows + 1 ) * ( cols + 1 ), 0 );
+
+        // m_keepOutSums[(row + 1) * (cols + 1) + col + 1] is the sum of the distances of the
+        // cells above and left of (row, col), included
+        int64_t* sums = m_keepOutSums[side].data();
+
+        for( int row = 0; row < rows; row++ )
+        {
+            uint64_t* zone = &m_zoneCells[side][(size_t) row * m_wordsPerRow];
+            uint64_t* footprint = &m_footprintCells[side][(size_t) row * m_wordsPerRow];
+            int64_t   rowSum = 0;
+
+            for( int col = 0; col < cols; col++ )
+            {
+                unsigned int data = m_matrix.GetCell( row, col, side );
+                uint64_t     bit = uint64_t( 1 ) << ( col % 64 );
+
+                if( data & CELL_IS_ZONE )
+                    zone[col / 64] |= bit;
+
+                if( data & CELL_IS_MODULE )
+                    footprint[col / 64] |= bit;
+
+                rowSum += m_matrix.GetDist( row, col, side );
+                sums[( row + 1 ) * ( cols + 1 ) + col + 1] = sums[row * ( cols + 1 ) + col + 1]
+                                                             + rowSum;
+            }
+        }
+    }
+
+    m_placementMapValid = true;
+}
+
+
+bool AR_AUTOPLACER::getCellRange( const EDA_RECT& aRect, int& aRowMin, int& aRowMax,
+                                  int& aColMin, int& aColMax ) const
+{
+    wxPoint start   = aRect.GetOrigin();
+    wxPoint end     = aRect.GetEnd();
+
+    start   -= m_matrix.m_BrdBox.GetOrigin();
+    end     -= m_matrix.m_BrdBox.GetOrigin();
+
+    aRowMin = start.y / m_matrix.m_GridRouting;
+    aRowMax = end.y / m_matrix.m_GridRouting;
+    aColMin = start.x / m_matrix.m_GridRouting;
+    aColMax = end.x / m_matrix.m_GridRouting;
+
+    if( start.y > aRowMin * m_matrix.m_GridRouting )
+        aRowMin++;
+
+    if( start.x > aColMin * m_matrix.m_GridRouting )
+        aColMin++;
+
+    if( aRowMin < 0 )
+        aRowMin = 0;
+
+    if( aRowMax >= ( m_matrix.m_Nrows - 1 ) )
+        aRowMax = m_matrix.m_Nrows - 1;
+
+    if( aColMin < 0 )
+        aColMin = 0;
+
+    if( aColMax >= ( m_matrix.m_Ncols - 1 ) )
+        aColMax = m_matrix.m_Ncols - 1;
+
+    return aRowMin <= aRowMax && aColMin <= aColMax;
+}
+
+
 /* Test if the rectangular area (ux, ux .. y0, y1):
  * - is a free zone (except OCCUPED_By_MODULE returns)
  * - is on the working surface of the board (otherwise returns OUT_OF_BOARD)
  *
  * Returns OUT_OF_BOARD, or OCCUPED_By_MODULE or FREE_CELL if OK
  */
-int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
+int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side ) const
 {
     EDA_RECT rect = aRect;
 
     rect.Inflate( m_matrix.m_GridRouting / 2 );
 
-    wxPoint start   = rect.GetOrigin();
-    wxPoint end     = rect.GetEnd();
+    int row_min, row_max, col_min, col_max;
 
-    start   -= m_matrix.m_BrdBox.GetOrigin();
-    end     -= m_matrix.m_BrdBox.GetOrigin();
+    if( !getCellRange( rect, row_min, row_max, col_min, col_max ) )
+        return AR_FREE_CELL;
 
-    int row_min = start.y / m_matrix.m_GridRouting;
-    int row_max = end.y / m_matrix.m_GridRouting;
-    int col_min = start.x / m_matrix.m_GridRouting;
-    int col_max = end.x / m_matrix.m_GridRouting;
+    int word_min = col_min / 64;
+    int word_max = col_max / 64;
 
-    if( start.y > row_min * m_matrix.m_GridRouting )
-        row_min++;
+    for( int row = row_min; row <= row_max; row++ )
+    {
+        const uint64_t* zone = &m_zoneCells[side][(size_t) row * m_wordsPerRow];
+        const uint64_t* footprint = &m_footprintCells[side][(size_t) row * m_wordsPerRow];
 
-    if( start.x > col_min * m_matrix.m_GridRouting )
-        col_min++;
+        // Test 64 cells at a time: a cell fails if it is outside the zone or occupied
+        for( int word = word_min; word <= word_max; word++ )
+        {
+            uint64_t mask = ~uint64_t( 0 );
 
-    if( row_min < 0 )
-        row_min = 0;
+            if( word == word_min )
+                mask &= ~uint64_t( 0 ) << ( col_min % 64 );
 
-    if( row_max >= ( m_matrix.m_Nrows - 1 ) )
-        row_max = m_matrix.m_Nrows - 1;
+            if( word == word_max )
+                mask &= ~uint64_t( 0 ) >> ( 63 - col_max % 64 );
 
-    if( col_min < 0 )
-        col_min = 0;
+            uint64_t failed = ( ~zone[word] | footprint[word] ) & mask;
 
-    if( col_max >= ( m_matrix.m_Ncols - 1 ) )
-        col_max = m_matrix.m_Ncols - 1;
+            if( !failed )
+                continue;
 
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            unsigned int data = m_matrix.GetCell( row, col, side );
+            // Report the first failing cell of the row, as a cell by cell scan would
+            uint64_t bit = uint64_t( 1 );
 
-            if( ( data & CELL_IS_ZONE ) == 0 )
+            while( !( failed & bit ) )
+                bit <<= 1;
+
+            if( ( zone[word] & bit ) == 0 )
                 return AR_OUT_OF_BOARD;
 
-            if( (data & CELL_IS_MODULE) )
-                return AR_OCCUIPED_BY_MODULE;
+            return AR_OCCUIPED_BY_MODULE;
         }
     }
 
@@ -492,52 +587,23 @@ int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
  * aRect):
  * (Sum of cells in terms of distance)
  */
-unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int side )
+unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int side ) const
 {
-    wxPoint start   = aRect.GetOrigin();
-    wxPoint end     = aRect.GetEnd();
-
-    start   -= m_matrix.m_BrdBox.GetOrigin();
-    end     -= m_matrix.m_BrdBox.GetOrigin();
-
-    int row_min = start.y / m_matrix.m_GridRouting;
-    int row_max = end.y / m_matrix.m_GridRouting;
-    int col_min = start.x / m_matrix.m_GridRouting;
-    int col_max = end.x / m_matrix.m_GridRouting;
-
-    if( start.y > row_min * m_matrix.m_GridRouting )
-        row_min++;
-
-    if( start.x > col_min * m_matrix.m_GridRouting )
-        col_min++;
-
-    if( row_min < 0 )
-        row_min = 0;
+    int row_min, row_max, col_min, col_max;
 
-    if( row_max >= ( m_matrix.m_Nrows - 1 ) )
-        row_max = m_matrix.m_Nrows - 1;
-
-    if( col_min < 0 )
-        col_min = 0;
-
-    if( col_max >= ( m_matrix.m_Ncols - 1 ) )
-        col_max = m_matrix.m_Ncols - 1;
+    if( !getCellRange( aRect, row_min, row_max, col_min, col_max ) )
+        return 0;
 
-    unsigned int keepOutCost = 0;
+    // The "cost" of the cells inside aRect, read from the summed area table
+    const int64_t* sums = m_keepOutSums[side].data();
+    int            stride = m_matrix.m_Ncols + 1;
 
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            // m_matrix.GetDist returns the "cost" of the cell
-            // at position (row, col)
-            // in autoplace this is the cost of the cell, if it is
-            // inside aRect
-            keepOutCost += m_matrix.GetDist( row, col, side );
-        }
-    }
+    int64_t keepOutCost = sums[( row_max + 1 ) * stride + col_max + 1]
+                          - sums[row_min * stride + col_max + 1]
+                          - sums[( row_max + 1 ) * stride + col_min]
+                          + sums[row_min * stride + col_min];
 
-    return keepOutCost;
+    return (unsigned int) keepOutCost;
 }
 
 
@@ -545,8 +611,8 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int sid
  * Returns the value TstRectangle().
  * Module is known by its bounding box
  */
-int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSide,
-                                         const wxPoint& aOffset )
+int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, const EDA_RECT& aFpBBox,
+                                         bool TstOtherSide ) const
 {
     int side = AR_SIDE_TOP;
     int otherside = AR_SIDE_BOTTOM;
@@ -556,21 +622,14 @@ int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSid
         side = AR_SIDE_BOTTOM; otherside = AR_SIDE_TOP;
     }
 
-    EDA_RECT    fpBBox = aFootprint->GetBoundingBox( false, false );
-    fpBBox.Move( -aOffset );
-
-    buildFpAreas( aFootprint, 0 );
-
-    int diag = //testModuleByPolygon( aFootprint, side, aOffset );
-        testRectangle( fpBBox, side );
+    int diag = testRectangle( aFpBBox, side );
 
     if( diag != AR_FREE_CELL )
         return diag;
 
     if( TstOtherSide )
     {
-        diag = //testModuleByPolygon( aFootprint, otherside, aOffset );
-                testRectangle( fpBBox, otherside );
+        diag = testRectangle( aFpBBox, otherside );
 
         if( diag != AR_FREE_CELL )
             return diag;
@@ -578,8 +637,9 @@ int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSid
 
     int marge = ( m_matrix.m_GridRouting * aFootprint->GetPadCount() ) / AR_GAIN;
 
-    fpBBox.Inflate( marge );
-    return calculateKeepOutArea( fpBBox, side );
+    EDA_RECT keepOutBBox = aFpBBox;
+    keepOutBBox.Inflate( marge );
+    return calculateKeepOutArea( keepOutBBox, side );
 }
 
 
@@ -587,9 +647,12 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
 {
     int     error = 1;
     wxPoint lastPosOK;
-    double  min_cost, curr_cost, Score;
+    double  min_cost;
     bool    testOtherSide;
 
+    if( !m_placementMapValid )
+        buildPlacementMap();
+
     lastPosOK = m_matrix.m_BrdBox.GetOrigin();
 
     wxPoint  fpPos = aFootprint->GetPosition();
@@ -608,9 +671,6 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
     initialPos.x    -= initialPos.x % m_matrix.m_GridRouting;
     initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
 
-    m_curPosition = initialPos;
-    wxPoint fpOffset = fpPos - m_curPosition;
-
     // Examine pads, and set testOtherSide to true if a footprint has at least 1 pad through.
     testOtherSide = false;
 
@@ -628,42 +688,87 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
         }
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-
-    min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
-
+    std::vector<RATSNEST_PAD> ratsnestPads;
+    buildRatsnestPads( aFootprint, ratsnestPads );
 
-    for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
+    struct CANDIDATE
     {
-        m_curPosition.y = initialPos.y;
+        double  m_score = -1.0;
+        wxPoint m_position;
+    };
 
-        for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
-        {
+    // Each column of positions is scored by one thread, which keeps its best position
+    size_t columnCount = 0;
 
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            fpOffset = fpPos - m_curPosition;
-            int keepOutCost = testFootprintOnBoard( aFootprint, testOtherSide, fpOffset );
+    if( xylimit.x > initialPos.x )
+        columnCount = ( xylimit.x - initialPos.x - 1 ) / m_matrix.m_GridRouting + 1;
 
-            if( keepOutCost >= 0 )    // i.e. if the footprint can be put here
-            {
-                error = 0;
-                // m_frame->build_ratsnest_footprint( aFootprint ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aFootprint, fpOffset );
-                Score       = curr_cost + keepOutCost;
+    std::vector<CANDIDATE> columnBest( columnCount );
+    std::atomic<size_t>    nextColumn( 0 );
 
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
+    auto score_lambda =
+            [&]()
+            {
+                for( size_t ii = nextColumn++; ii < columnCount; ii = nextColumn++ )
                 {
-                    lastPosOK   = m_curPosition;
-                    min_cost    = Score;
-                    wxString msg;
-/*                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                GetChars( ::CoordinateToString( LastPosOK.x ) ),
-                                GetChars( ::CoordinateToString( LastPosOK.y ) ) );
-                    m_frame->SetStatusText( msg );*/
+                    CANDIDATE& best = columnBest[ii];
+                    wxPoint    pos( initialPos.x + (int) ii * m_matrix.m_GridRouting,
+                                    initialPos.y );
+                    EDA_RECT   bbox = fpBBox;
+
+                    for( ; pos.y < xylimit.y; pos.y += m_matrix.m_GridRouting )
+                    {
+                        bbox.SetOrigin( fpBBoxOrg + pos );
+                        int keepOutCost = testFootprintOnBoard( aFootprint, bbox, testOtherSide );
+
+                        if( keepOutCost >= 0 )    // i.e. if the footprint can be put here
+                        {
+                            double score = computePlacementRatsnestCost( ratsnestPads,
+                                                                         fpPos - pos );
+                            score += keepOutCost;
+
+                            if( ( best.m_score >= score ) || ( best.m_score < 0 ) )
+                            {
+                                best.m_score = score;
+                                best.m_position = pos;
+                            }
+                        }
+                    }
                 }
-            }
+            };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   columnCount );
+
+    if( parallelThreadCount <= 1 )
+    {
+        score_lambda();
+    }
+    else
+    {
+        std::vector<std::future<void>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, score_lambda );
+
+        for( const std::future<void>& ret : returns )
+            ret.wait();
+    }
+
+    // Merge the columns in scan order, so that ties are resolved as by a serial scan
+    min_cost = -1.0;
+
+    for( const CANDIDATE& candidate : columnBest )
+    {
+        if( candidate.m_score < 0 )
+            continue;
+
+        error = 0;
+
+        if( ( min_cost >= candidate.m_score ) || ( min_cost < 0 ) )
+        {
+            lastPosOK   = candidate.m_position;
+            min_cost    = candidate.m_score;
         }
     }
 
@@ -675,39 +780,40 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
 }
 
 
-const PAD* AR_AUTOPLACER::nearestPad( FOOTPRINT *aRefFP, PAD* aRefPad, const wxPoint& aOffset)
+void AR_AUTOPLACER::buildRatsnestPads( FOOTPRINT* aFootprint,
+                                       std::vector<RATSNEST_PAD>& aPads ) const
 {
-    const PAD* nearest = nullptr;
-    int64_t    nearestDist = INT64_MAX;
+    aPads.clear();
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
+    for( PAD* refPad : aFootprint->Pads() )
     {
-        if ( footprint == aRefFP )
-            continue;
-
-        if( !m_matrix.m_BrdBox.Contains( footprint->GetPosition() ) )
-            continue;
+        RATSNEST_PAD ratsnestPad;
+        ratsnestPad.m_position = refPad->GetPosition();
 
-        for( PAD* pad: footprint->Pads() )
+        for( FOOTPRINT* footprint : m_board->Footprints() )
         {
-            if( pad->GetNetCode() != aRefPad->GetNetCode() || pad->GetNetCode() <= 0 )
+            if ( footprint == aFootprint )
                 continue;
 
-            auto dist = (VECTOR2I( aRefPad->GetPosition() - aOffset ) - VECTOR2I( pad->GetPosition() ) ).EuclideanNorm();
+            if( !m_matrix.m_BrdBox.Contains( footprint->GetPosition() ) )
+                continue;
 
-            if ( dist < nearestDist )
+            for( PAD* pad: footprint->Pads() )
             {
-                nearestDist = dist;
-                nearest = pad;
+                if( pad->GetNetCode() != refPad->GetNetCode() || pad->GetNetCode() <= 0 )
+                    continue;
+
+                ratsnestPad.m_targets.push_back( pad->GetPosition() );
             }
         }
-    }
 
-    return nearest;
+        aPads.push_back( std::move( ratsnestPad ) );
+    }
 }
 
 
-double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT *aFootprint, const wxPoint& aOffset )
+double AR_AUTOPLACER::computePlacementRatsnestCost( const std::vector<RATSNEST_PAD>& aPads,
+                                                    const wxPoint& aOffset ) const
 {
     double  curr_cost;
     VECTOR2I start;      // start point of a ratsnest
@@ -716,19 +822,26 @@ double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT *aFootprint, const
 
     curr_cost = 0;
 
-    for( PAD* pad : aFootprint->Pads() )
+    for( const RATSNEST_PAD& pad : aPads )
     {
-        const PAD* nearest = nearestPad( aFootprint, pad, aOffset );
-
-        if( !nearest )
+        if( pad.m_targets.empty() )
             continue;
 
-        start   = VECTOR2I( pad->GetPosition() ) - VECTOR2I(aOffset);
-        end     = VECTOR2I( nearest->GetPosition() );
+        start   = pad.m_position - VECTOR2I( aOffset );
+
+        // The nearest pad of the same net
+        int64_t nearestDist = INT64_MAX;
 
-        //m_overlay->SetIsStroke( true );
-        //m_overlay->SetStrokeColor( COLOR4D(0.0, 1.0, 0.0, 1.0) );
-        //m_overlay->Line( start, end );
+        for( const VECTOR2I& target : pad.m_targets )
+        {
+            auto dist = ( start - target ).EuclideanNorm();
+
+            if ( dist < nearestDist )
+            {
+                nearestDist = dist;
+                end = target;
+            }
+        }
 
         // Cost of the ratsnest.
         dx  = end.x - start.x;
@@ -95,11 +95,37 @@ private:
     bool fillMatrix();
     void genModuleOnRoutingMatrix( FOOTPRINT* aFootprint );
 
-    int testRectangle( const EDA_RECT& aRect, int side );
-    unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side );
-    int testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSide, const wxPoint& aOffset );
+    /**
+     * Pack m_matrix into m_zoneCells, m_footprintCells and m_keepOutSums.
+     *
+     * The placement tests only read these, so they can run from several threads.
+     */
+    void buildPlacementMap();
+
+    /**
+     * Compute the range of matrix cells covered by \a aRect.
+     *
+     * @return false if the range is empty.
+     */
+    bool getCellRange( const EDA_RECT& aRect, int& aRowMin, int& aRowMax, int& aColMin,
+                       int& aColMax ) const;
+
+    int testRectangle( const EDA_RECT& aRect, int side ) const;
+    unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side ) const;
+    int testFootprintOnBoard( FOOTPRINT* aFootprint, const EDA_RECT& aFpBBox,
+                              bool TstOtherSide ) const;
     int getOptimalFPPlacement( FOOTPRINT* aFootprint );
-    double computePlacementRatsnestCost( FOOTPRINT* aFootprint, const wxPoint& aOffset );
+
+    /// A pad of the footprint to place, and the pads of the board on the same net.
+    struct RATSNEST_PAD
+    {
+        VECTOR2I              m_position;
+        std::vector<VECTOR2I> m_targets;
+    };
+
+    void buildRatsnestPads( FOOTPRINT* aFootprint, std::vector<RATSNEST_PAD>& aPads ) const;
+    double computePlacementRatsnestCost( const std::vector<RATSNEST_PAD>& aPads,
+                                         const wxPoint& aOffset ) const;
 
     /**
      * Find the "best" footprint place. The criteria are:
@@ -110,8 +136,6 @@ private:
 
     void placeFootprint( FOOTPRINT* aFootprint, bool aDoNotRecreateRatsnest, const wxPoint& aPos );
 
-    const PAD* nearestPad( FOOTPRINT* aRefFP, PAD* aRefPad, const wxPoint& aOffset );
-
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
     void addFpBody( wxPoint aStart, wxPoint aEnd, LSET aLayerMask );
 
@@ -123,6 +147,15 @@ private:
     void buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance );
 
     AR_MATRIX m_matrix;
+
+    // Packed copy of m_matrix used to test the footprint positions, rebuilt after m_matrix
+    // is modified.  Each row of cells is stored in m_wordsPerRow 64 bit words.
+    bool                  m_placementMapValid;
+    int                   m_wordsPerRow;
+    std::vector<uint64_t> m_zoneCells[AR_MAX_ROUTING_LAYERS_COUNT];      // CELL_IS_ZONE bits
+    std::vector<uint64_t> m_footprintCells[AR_MAX_ROUTING_LAYERS_COUNT]; // CELL_IS_MODULE bits
+    std::vector<int64_t>  m_keepOutSums[AR_MAX_ROUTING_LAYERS_COUNT];    // summed area table of
+                                                                         // the cell distances
     SHAPE_POLY_SET m_topFreeArea;       // The polygonal description of the top side free areas;
     SHAPE_POLY_SET m_bottomFreeArea;    // The polygonal description of the bottom side free areas;
     SHAPE_POLY_SET m_boardShape;        // The polygonal description of the board;
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <drc/drc_rtree.h>
 #include <pcb_base_frame.h>
 #include <board_design_settings.h>
@@ -203,6 +204,88 @@ void BOARD::IncrementTimeStamp()
     m_CopperZoneRTrees.clear();
 }
 
+
+std::shared_ptr<SHAPE> BOARD::GetCachedEffectiveShape( const BOARD_ITEM* aItem,
+                                                       PCB_LAYER_ID aLayer )
+{
+    int layer = UNDEFINED_LAYER;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_SHAPE_T:
+    case PCB_FP_SHAPE_T:
+        // Same shape on every layer
+        break;
+
+    case PCB_VIA_T:
+        // The flashed layers of a via with unconnected layers removed depend on the items
+        // around it, which can change without the via being touched
+        if( static_cast<const PCB_VIA*>( aItem )->GetRemoveUnconnected() )
+            return aItem->GetEffectiveShape( aLayer );
+
+        layer = aLayer;
+        break;
+
+    default:
+        // Pads keep their own shape cache; zones, texts and dimensions depend on state which
+        // isn't tracked by commits (fills, text variables...)
+        return aItem->GetEffectiveShape( aLayer );
+    }
+
+    const std::pair<const BOARD_ITEM*, int> key( aItem, layer );
+    const EDA_RECT                          bbox = aItem->GetBoundingBox();
+    EFFECTIVE_SHAPE_SHARD&                  shard = effectiveShapeShard( aItem );
+
+    {
+        std::unique_lock<std::mutex> cacheLock( shard.m_mutex );
+        auto                         it = shard.m_shapes.find( key );
+
+        if( it != shard.m_shapes.end()
+                && it->second.m_uuid == aItem->m_Uuid
+                && it->second.m_bbox.GetOrigin() == bbox.GetOrigin()
+                && it->second.m_bbox.GetSize() == bbox.GetSize() )
+        {
+            return it->second.m_shape;
+        }
+    }
+
+    std::shared_ptr<SHAPE> shape = aItem->GetEffectiveShape( aLayer );
+
+    std::unique_lock<std::mutex> cacheLock( shard.m_mutex );
+    shard.m_shapes[ key ] = { aItem->m_Uuid, bbox, shape };
+
+    return shape;
+}
+
+
+void BOARD::InvalidateEffectiveShape( const BOARD_ITEM* aItem )
+{
+    invalidateEffectiveShape( aItem );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        static_cast<const FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    invalidateEffectiveShape( aChild );
+                } );
+    }
+}
+
+
+void BOARD::invalidateEffectiveShape( const BOARD_ITEM* aItem )
+{
+    EFFECTIVE_SHAPE_SHARD&       shard = effectiveShapeShard( aItem );
+    std::unique_lock<std::mutex> cacheLock( shard.m_mutex );
+
+    auto it = shard.m_shapes.lower_bound( { aItem, std::numeric_limits<int>::min() } );
+
+    while( it != shard.m_shapes.end() && it->first.first == aItem )
+        it = shard.m_shapes.erase( it );
+}
+
 std::vector<PCB_MARKER*> BOARD::ResolveDRCExclusions()
 {
     for( PCB_MARKER* marker : GetBoard()->Markers() )
@@ -611,6 +694,8 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
         return;
     }
 
+    InvalidateEffectiveShape( aBoardItem );
+
     switch( aBoardItem->Type() )
     {
     case PCB_NETINFO_T:
@@ -710,6 +795,8 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
     // find these calls and fix them!  Don't send me no stinking' nullptr.
     wxASSERT( aBoardItem );
 
+    InvalidateEffectiveShape( aBoardItem );
+
     switch( aBoardItem->Type() )
     {
     case PCB_NETINFO_T:
@@ -2007,12 +2094,17 @@ void BOARD::RemoveListener( BOARD_LISTENER* aListener )
 
 void BOARD::OnItemChanged( BOARD_ITEM* aItem )
 {
+    InvalidateEffectiveShape( aItem );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *this, aItem );
 }
 
 
 void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 {
+    for( BOARD_ITEM* item : aItems )
+        InvalidateEffectiveShape( item );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *this, aItems );
 }
 
@@ -34,6 +34,7 @@
 #include <pcb_plot_params.h>
 #include <title_block.h>
 #include <tools/pcb_selection.h>
+#include <cstdint>
 #include <mutex>
 #include <list>
 
@@ -1087,6 +1088,31 @@ public:
 
     std::map< ZONE*, std::unique_ptr<DRC_RTREE> >         m_CopperZoneRTrees;
 
+    /**
+     * Return the effective shape of \a aItem on \a aLayer, shared with the other users of the
+     * board.
+     *
+     * Shapes of tracks, arcs, vias and graphic shapes are built once and kept until a commit,
+     * an undo or a redo touches their item; an entry is also rebuilt when the item's UUID or
+     * bounding box no longer match it, which covers items moved without a commit and
+     * temporary copies.  Other items return their own GetEffectiveShape().
+     *
+     * A change made outside a commit which keeps the bounding box of the item (for instance
+     * moving the middle point of an arc within its box) is not detected: code doing so must
+     * call InvalidateEffectiveShape().
+     *
+     * The returned shape must not be modified.  Thread-safe; the entries are spread over
+     * several independently locked maps so that parallel DRC threads seldom wait for each
+     * other.
+     */
+    std::shared_ptr<SHAPE> GetCachedEffectiveShape( const BOARD_ITEM* aItem,
+                                                    PCB_LAYER_ID aLayer = UNDEFINED_LAYER );
+
+    /**
+     * Drop the cached effective shapes of \a aItem (and of its children for a footprint).
+     */
+    void InvalidateEffectiveShape( const BOARD_ITEM* aItem );
+
 private:
     // The default copy constructor & operator= are inadequate,
     // either write one or do not use it at all
@@ -1094,6 +1120,32 @@ private:
 
     BOARD& operator=( const BOARD& aOther ) = delete;
 
+    struct CACHED_SHAPE
+    {
+        KIID                   m_uuid;
+        EDA_RECT               m_bbox;
+        std::shared_ptr<SHAPE> m_shape;
+    };
+
+    /// A part of the effective shape cache, with its own lock
+    struct EFFECTIVE_SHAPE_SHARD
+    {
+        std::mutex                                                  m_mutex;
+        std::map< std::pair<const BOARD_ITEM*, int>, CACHED_SHAPE > m_shapes;
+    };
+
+    static constexpr size_t EFFECTIVE_SHAPE_SHARD_COUNT = 16;
+
+    EFFECTIVE_SHAPE_SHARD& effectiveShapeShard( const BOARD_ITEM* aItem )
+    {
+        // Items are allocated on the heap, so the lowest bits of their address carry no
+        // information
+        return m_effectiveShapes[ ( reinterpret_cast<uintptr_t>( aItem ) >> 4 )
+                                  % EFFECTIVE_SHAPE_SHARD_COUNT ];
+    }
+
+    void invalidateEffectiveShape( const BOARD_ITEM* aItem );
+
     template <typename Func, typename... Args>
     void InvokeListeners( Func&& aFunc, Args&&... args )
     {
@@ -1105,6 +1157,8 @@ private:
 
     /// What is this board being used for
     BOARD_USE           m_boardUse;
+
+    EFFECTIVE_SHAPE_SHARD m_effectiveShapes[EFFECTIVE_SHAPE_SHARD_COUNT];
     int                 m_timeStamp;                // actually a modification counter
 
     wxString            m_fileName;
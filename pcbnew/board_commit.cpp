@@ -112,6 +112,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
         int changeFlags = ent.m_type & CHT_FLAGS;
         BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
 
+        // Footprint children deleted in the footprint editor don't go through BOARD::Remove()
+        board->InvalidateEffectiveShape( boardItem );
+
         // Module items need to be saved in the undo buffer before modification
         if( m_isFootprintEditor )
         {
@@ -430,6 +430,8 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     size *= 2;      // Our caller us gets the other half of the progress bar
 
+    m_itemList.BeginBulkLoad();
+
     for( ZONE* zone : aBoard->Zones() )
     {
         Add( zone );
@@ -450,11 +452,15 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
             reportProgress( aReporter, ii++, size, delta );
         }
     }
+
+    m_itemList.EndBulkLoad();
 }
 
 
 void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
 {
+    m_itemList.BeginBulkLoad();
+
     for( auto item : aItems )
     {
         switch( item->Type() )
@@ -476,6 +482,8 @@ void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
                 break;
         }
     }
+
+    m_itemList.EndBulkLoad();
 }
 
 
@@ -169,6 +169,19 @@ public:
         return m_itemMap[ aItem ];
     }
 
+    /**
+     * Return the entry of \a aItem, or nullptr if the item is unknown.
+     *
+     * Unlike ItemEntry(), this never adds an entry to the map, so it can be called from several
+     * threads as long as the connectivity isn't modified.
+     */
+    const ITEM_MAP_ENTRY* FindItemEntry( const BOARD_CONNECTED_ITEM* aItem ) const
+    {
+        auto it = m_itemMap.find( aItem );
+
+        return it != m_itemMap.end() ? &it->second : nullptr;
+    }
+
     bool IsNetDirty( int aNet ) const
     {
         if( aNet < 0 )
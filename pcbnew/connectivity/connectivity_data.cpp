@@ -348,7 +348,10 @@ void CONNECTIVITY_DATA::PropagateNets( BOARD_COMMIT* aCommit, PROPAGATE_MODE aMo
 bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, int aLayer,
                                             std::vector<KICAD_T> aTypes ) const
 {
-    CN_CONNECTIVITY_ALGO::ITEM_MAP_ENTRY &entry = m_connAlgo->ItemEntry( aItem );
+    const CN_CONNECTIVITY_ALGO::ITEM_MAP_ENTRY* entry = m_connAlgo->FindItemEntry( aItem );
+
+    if( !entry )
+        return false;
 
     auto matchType = [&]( KICAD_T aItemType )
     {
@@ -358,7 +361,7 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
         return std::count( aTypes.begin(), aTypes.end(), aItemType ) > 0;
     };
 
-    for( CN_ITEM* citem : entry.GetItems() )
+    for( CN_ITEM* citem : entry->GetItems() )
     {
         for( CN_ITEM* connected : citem->ConnectedItems() )
         {
@@ -512,7 +515,12 @@ const std::vector<PCB_TRACK*> CONNECTIVITY_DATA::GetConnectedTracks(
 void CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem,
                                           std::set<PAD*>* pads ) const
 {
-    for( CN_ITEM* citem : m_connAlgo->ItemEntry( aItem ).GetItems() )
+    const CN_CONNECTIVITY_ALGO::ITEM_MAP_ENTRY* entry = m_connAlgo->FindItemEntry( aItem );
+
+    if( !entry )
+        return;
+
+    for( CN_ITEM* citem : entry->GetItems() )
     {
         for( CN_ITEM* connected : citem->ConnectedItems() )
         {
@@ -204,6 +204,10 @@ public:
 
     const std::vector<PCB_TRACK*> GetConnectedTracks( const BOARD_CONNECTED_ITEM* aItem ) const;
 
+    /**
+     * Return the pads connected to \a aItem.  This doesn't modify the connectivity, so it can
+     * be called from several threads at once.
+     */
     const std::vector<PAD*> GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem ) const;
 
     void GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem, std::set<PAD*>* pads ) const;
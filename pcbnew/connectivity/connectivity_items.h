@@ -359,7 +359,8 @@ protected:
 
     void addItemtoTree( CN_ITEM* item )
     {
-        m_index.Insert( item );
+        if( !m_bulkLoading )
+            m_index.Insert( item );
     }
 
 public:
@@ -367,6 +368,25 @@ public:
     {
         m_dirty = false;
         m_hasInvalid = false;
+        m_bulkLoading = false;
+    }
+
+    /**
+     * Stop indexing the items as they are added.  FindNearby() must not be used until
+     * EndBulkLoad() has been called.
+     */
+    void BeginBulkLoad()
+    {
+        m_bulkLoading = true;
+    }
+
+    /**
+     * Index all the items at once, which is much faster than inserting them one by one.
+     */
+    void EndBulkLoad()
+    {
+        m_bulkLoading = false;
+        m_index.BulkLoad( m_items );
     }
 
     void Clear()
@@ -376,6 +396,7 @@ public:
 
         m_items.clear();
         m_index.RemoveAll();
+        m_bulkLoading = false;
     }
 
     using ITER       = decltype( m_items )::iterator;
@@ -443,6 +464,7 @@ public:
 private:
     bool                  m_dirty;
     bool                  m_hasInvalid;
+    bool                  m_bulkLoading;
 
     CN_RTREE<CN_ITEM*>    m_index;
 };
@@ -29,6 +29,8 @@
 
 #include <geometry/rtree.h>
 
+#include <vector>
+
 
 /**
  * CN_RTREE -
@@ -65,6 +67,31 @@ public:
         m_tree->Insert( mmin, mmax, aItem );
     }
 
+    /**
+     * Function BulkLoad()
+     * Replaces the contents of the tree with the given items, packed at once.  This is much
+     * faster than inserting them one by one.
+     */
+    void BulkLoad( const std::vector<T>& aItems )
+    {
+        using RECT = typename RTree<T, int, 3, double>::Rect;
+
+        std::vector<std::pair<RECT, T>> entries;
+        entries.reserve( aItems.size() );
+
+        for( T item : aItems )
+        {
+            const BOX2I&        bbox    = item->BBox();
+            const LAYER_RANGE   layers  = item->Layers();
+
+            entries.emplace_back( RECT{ { layers.Start(), bbox.GetX(), bbox.GetY() },
+                                        { layers.End(), bbox.GetRight(), bbox.GetBottom() } },
+                                  item );
+        }
+
+        m_tree->BulkLoad( entries );
+    }
+
     /**
      * Function Remove()
      * Removes an item from the tree. Removal is done by comparing pointers, attempting
@@ -704,31 +704,34 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
     // Number of zones between progress bar updates
     int                delta = 5;
+    std::vector<ZONE*> allZones;
     std::vector<ZONE*> copperZones;
 
     for( ZONE* zone : m_board->Zones() )
-    {
-        zone->CacheBoundingBox();
-        zone->CacheTriangulation();
-
-        if( !zone->GetIsRuleArea() )
-            copperZones.push_back( zone );
-    }
+        allZones.push_back( zone );
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
         for( ZONE* zone : footprint->Zones() )
-        {
-            zone->CacheBoundingBox();
-            zone->CacheTriangulation();
-
-            if( !zone->GetIsRuleArea() )
-                copperZones.push_back( zone );
-        }
+            allZones.push_back( zone );
 
         footprint->BuildPolyCourtyards();
     }
 
+    // The polygons of large zones are triangulated in parallel; small zones are cheap enough
+    // to be done in sequence
+    for( ZONE* zone : allZones )
+    {
+        zone->CacheBoundingBox();
+        zone->CacheTriangulation( UNDEFINED_LAYER, true );
+    }
+
+    for( ZONE* zone : allZones )
+    {
+        if( !zone->GetIsRuleArea() )
+            copperZones.push_back( zone );
+    }
+
     int zoneCount = copperZones.size();
 
     for( int ii = 0; ii < zoneCount; ++ii )
@@ -741,13 +744,18 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
                 return;
         }
 
-        m_board->m_CopperZoneRTrees[ zone ] = std::make_unique<DRC_RTREE>();
+        std::unique_ptr<DRC_RTREE>& zoneTree = m_board->m_CopperZoneRTrees[ zone ];
+
+        zoneTree = std::make_unique<DRC_RTREE>();
+        zoneTree->BeginBulkLoad();
 
         for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
         {
             if( IsCopperLayer( layer ) )
-                m_board->m_CopperZoneRTrees[ zone ]->Insert( zone, layer );
+                zoneTree->Insert( zone, layer );
         }
+
+        zoneTree->EndBulkLoad();
     }
 
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
@@ -1307,6 +1315,9 @@ std::shared_ptr<SHAPE> DRC_ENGINE::GetShape( BOARD_ITEM* aItem, PCB_LAYER_ID aLa
         return std::make_shared<SHAPE_NULL>();
     }
 
+    if( BOARD* board = aItem->GetBoard() )
+        return board->GetCachedEffectiveShape( aItem, aLayer );
+
     return aItem->GetEffectiveShape( aLayer );
 }
 
@@ -26,6 +26,7 @@
 #define DRC_RTREE_H_
 
 #include <eda_rect.h>
+#include <board.h>
 #include <board_item.h>
 #include <fp_text.h>
 #include <memory>
@@ -66,12 +67,24 @@ private:
 
 public:
 
-    DRC_RTREE()
+    /**
+     * @param aShareShapes use the shapes cached by the board (see
+     *                     BOARD::GetCachedEffectiveShape()).  Trees built once for a
+     *                     short-lived job over items which are about to change should not fill
+     *                     the board cache.
+     */
+    DRC_RTREE( bool aShareShapes = true )
     {
+        m_shareShapes = aShareShapes;
+
         for( int layer : LSET::AllLayersMask().Seq() )
+        {
             m_tree[layer] = new drc_rtree();
+            m_layerCount[layer] = 0;
+        }
 
         m_count = 0;
+        m_bulkLoading = false;
     }
 
     ~DRC_RTREE()
@@ -91,7 +104,7 @@ public:
             return;
 
         std::vector<SHAPE*> subshapes;
-        std::shared_ptr<SHAPE> shape = aItem->GetEffectiveShape( ToLAYER_ID( aLayer ) );
+        std::shared_ptr<SHAPE> shape = getShape( aItem, ToLAYER_ID( aLayer ) );
         subshapes.clear();
 
         if( shape->HasIndexableSubshapes() )
@@ -109,11 +122,66 @@ public:
             const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, subshape, shape );
 
-            m_tree[aLayer]->Insert( mmin, mmax, itemShape );
+            if( m_bulkLoading )
+                m_pending[aLayer].emplace_back( drc_rtree::Rect{ { mmin[0], mmin[1] },
+                                                                 { mmax[0], mmax[1] } },
+                                                itemShape );
+            else
+            {
+                m_tree[aLayer]->Insert( mmin, mmax, itemShape );
+                m_layerCount[aLayer]++;
+            }
+
             m_count++;
         }
     }
 
+    /**
+     * Start collecting the items passed to Insert() instead of inserting them one by one.
+     *
+     * The collected items are only searchable once EndBulkLoad() has been called.  Use this
+     * when indexing a whole board: packing the trees at once is much faster than inserting the
+     * items one by one, and gives trees with less overlap which are faster to query.
+     */
+    void BeginBulkLoad()
+    {
+        m_bulkLoading = true;
+    }
+
+    /**
+     * Add the items collected since BeginBulkLoad() to the trees.
+     *
+     * Empty layer trees are packed from the collected items; layers which already hold items
+     * get the new ones inserted one by one.
+     */
+    void EndBulkLoad()
+    {
+        m_bulkLoading = false;
+
+        for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+        {
+            std::vector<std::pair<drc_rtree::Rect, ITEM_WITH_SHAPE*>>& pending = m_pending[layer];
+
+            if( pending.empty() )
+                continue;
+
+            if( m_layerCount[layer] == 0 )
+            {
+                m_tree[layer]->BulkLoad( pending );
+            }
+            else
+            {
+                for( const std::pair<drc_rtree::Rect, ITEM_WITH_SHAPE*>& entry : pending )
+                    m_tree[layer]->Insert( entry.first.m_min, entry.first.m_max, entry.second );
+            }
+
+            m_layerCount[layer] += pending.size();
+
+            pending.clear();
+            pending.shrink_to_fit();
+        }
+    }
+
     /**
      * Remove all items from the RTree.
      */
@@ -122,7 +190,14 @@ public:
         for( auto tree : m_tree )
             tree->RemoveAll();
 
+        for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+        {
+            m_pending[layer].clear();
+            m_layerCount[layer] = 0;
+        }
+
         m_count = 0;
+        m_bulkLoading = false;
     }
 
     bool CheckColliding( SHAPE* aRefShape, PCB_LAYER_ID aTargetLayer, int aClearance = 0,
@@ -184,7 +259,7 @@ public:
         int min[2] = { box.GetX(),         box.GetY() };
         int max[2] = { box.GetRight(),     box.GetBottom() };
 
-        std::shared_ptr<SHAPE> refShape = aRefItem->GetEffectiveShape( aRefLayer );
+        std::shared_ptr<SHAPE> refShape = getShape( aRefItem, aRefLayer );
 
         int count = 0;
 
@@ -473,8 +548,25 @@ public:
 
 
 private:
+    std::shared_ptr<SHAPE> getShape( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer ) const
+    {
+        BOARD* board = m_shareShapes ? aItem->GetBoard() : nullptr;
+
+        if( board )
+            return board->GetCachedEffectiveShape( aItem, aLayer );
+
+        return aItem->GetEffectiveShape( aLayer );
+    }
+
     drc_rtree*  m_tree[PCB_LAYER_ID_COUNT];
     size_t      m_count;
+
+    size_t      m_layerCount[PCB_LAYER_ID_COUNT];   // items in each layer tree
+    bool        m_bulkLoading;
+    bool        m_shareShapes;
+
+    // Items collected between BeginBulkLoad() and EndBulkLoad()
+    std::vector<std::pair<drc_rtree::Rect, ITEM_WITH_SHAPE*>> m_pending[PCB_LAYER_ID_COUNT];
 };
 
 
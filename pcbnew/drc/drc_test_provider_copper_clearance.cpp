@@ -199,7 +199,10 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
     };
 
     forEachGeometryItem( itemTypes, LSET::AllCuMask(), countItems );
+
+    m_copperTree.BeginBulkLoad();
     forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
+    m_copperTree.EndBulkLoad();
 
     reportAux( "Testing %d copper items and %d zones...", count, m_zones.size() );
 
@@ -404,7 +407,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZones( BOARD_ITEM* aItem
             VECTOR2I               pos;
             DRC_RTREE*             zoneTree = m_board->m_CopperZoneRTrees[ zone ].get();
             EDA_RECT               itemBBox = aItem->GetBoundingBox();
-            std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( aLayer );
+            std::shared_ptr<SHAPE> itemShape = m_board->GetCachedEffectiveShape( aItem, aLayer );
 
             if( aItem->Type() == PCB_PAD_T )
             {
@@ -465,7 +468,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 
         for( PCB_LAYER_ID layer : track->GetLayerSet().Seq() )
         {
-            std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
+            std::shared_ptr<SHAPE> trackShape = m_board->GetCachedEffectiveShape( track, layer );
 
             m_copperTree.QueryColliding( track, layer, layer,
                     // Filter:
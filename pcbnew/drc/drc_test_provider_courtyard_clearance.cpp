@@ -21,6 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
 #include <geometry/shape_poly_set.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
@@ -143,101 +149,189 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
 
 bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
 {
-    const int delta = 100;  // This is the number of tests between 2 calls to the progress bar
-
     if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS) )
         return true;   // continue with other tests
 
     if( !reportPhase( _( "Checking footprints for overlapping courtyards..." ) ) )
         return false;   // DRC cancelled
 
-    int ii = 0;
-
-    for( auto it1 = m_board->Footprints().begin(); it1 != m_board->Footprints().end(); it1++ )
+    struct COURTYARD
     {
-        if( !reportProgress( ii++, m_board->Footprints().size(), delta ) )
-            return false;   // DRC cancelled
+        size_t     m_index;     // index of the footprint in the board
+        FOOTPRINT* m_footprint;
+        BOX2I      m_bbox;
+    };
 
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS) )
-            break;
+    struct COURTYARD_PAIR
+    {
+        size_t         m_indexA;
+        size_t         m_indexB;
+        FOOTPRINT*     m_footprintA;
+        FOOTPRINT*     m_footprintB;
+        PCB_LAYER_ID   m_layer;
+        DRC_CONSTRAINT m_constraint;
+        int            m_clearance = 0;
+        bool           m_collides = false;
+        int            m_actual = 0;
+        VECTOR2I       m_pos;
+    };
+
+    std::vector<COURTYARD_PAIR> pairs;
+
+    // Sweep along X over the courtyard boxes of each side, so that only the footprints whose
+    // boxes come within the largest clearance are tested against each other
+    for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+    {
+        std::vector<COURTYARD> courtyards;
+        size_t                 ii = 0;
 
-        FOOTPRINT*            footprint = *it1;
-        const SHAPE_POLY_SET& footprintFront = footprint->GetPolyCourtyardFront();
-        const SHAPE_POLY_SET& footprintBack = footprint->GetPolyCourtyardBack();
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            const SHAPE_POLY_SET& courtyard = layer == F_Cu ? footprint->GetPolyCourtyardFront()
+                                                            : footprint->GetPolyCourtyardBack();
 
-        if( footprintFront.OutlineCount() == 0 && footprintBack.OutlineCount() == 0 )
-            continue; // No courtyards defined
+            if( courtyard.OutlineCount() > 0 )
+                courtyards.push_back( { ii, footprint, courtyard.BBoxFromCaches() } );
 
-        BOX2I frontBBox = footprintFront.BBoxFromCaches();
-        BOX2I backBBox = footprintBack.BBoxFromCaches();
+            ii++;
+        }
 
-        frontBBox.Inflate( m_largestClearance );
-        backBBox.Inflate( m_largestClearance );
+        std::sort( courtyards.begin(), courtyards.end(),
+                   []( const COURTYARD& aLeft, const COURTYARD& aRight )
+                   {
+                       return aLeft.m_bbox.GetLeft() < aRight.m_bbox.GetLeft();
+                   } );
 
-        for( auto it2 = it1 + 1; it2 != m_board->Footprints().end(); it2++ )
+        for( auto it1 = courtyards.begin(); it1 != courtyards.end(); it1++ )
         {
-            FOOTPRINT*            test = *it2;
-            const SHAPE_POLY_SET& testFront = test->GetPolyCourtyardFront();
-            const SHAPE_POLY_SET& testBack = test->GetPolyCourtyardBack();
-            DRC_CONSTRAINT        constraint;
-            int                   clearance;
-            int                   actual;
-            VECTOR2I              pos;
-
-            if( footprintFront.OutlineCount() > 0 && testFront.OutlineCount() > 0
-                    && frontBBox.Intersects( testFront.BBoxFromCaches() ) )
+            BOX2I sweepBBox = it1->m_bbox;
+            sweepBBox.Inflate( m_largestClearance );
+
+            for( auto it2 = it1 + 1; it2 != courtyards.end(); it2++ )
             {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, footprint,
-                                                     test, F_Cu );
-                clearance = constraint.GetValue().Min();
+                if( it2->m_bbox.GetLeft() > sweepBBox.GetRight() )
+                    break;
+
+                // Keep the board order of the footprints, and the original bounding box test
+                const COURTYARD& first = it1->m_index < it2->m_index ? *it1 : *it2;
+                const COURTYARD& second = it1->m_index < it2->m_index ? *it2 : *it1;
+
+                BOX2I firstBBox = first.m_bbox;
+                firstBBox.Inflate( m_largestClearance );
+
+                if( !firstBBox.Intersects( second.m_bbox ) )
+                    continue;
+
+                COURTYARD_PAIR pair;
+                pair.m_indexA = first.m_index;
+                pair.m_indexB = second.m_index;
+                pair.m_footprintA = first.m_footprint;
+                pair.m_footprintB = second.m_footprint;
+                pair.m_layer = layer;
+                pairs.push_back( pair );
+            }
+        }
+    }
 
-                if( clearance >= 0 && footprintFront.Collide( &testFront, clearance, &actual, &pos ) )
-                {
-                    std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+    // Report the violations in the order of a footprint by footprint scan
+    std::sort( pairs.begin(), pairs.end(),
+               []( const COURTYARD_PAIR& aLeft, const COURTYARD_PAIR& aRight )
+               {
+                   if( aLeft.m_indexA != aRight.m_indexA )
+                       return aLeft.m_indexA < aRight.m_indexA;
 
-                    if( clearance > 0 )
-                    {
-                        m_msg.Printf( _( "(%s clearance %s; actual %s)" ),
-                                      constraint.GetName(),
-                                      MessageTextFromValue( userUnits(), clearance ),
-                                      MessageTextFromValue( userUnits(), actual ) );
+                   if( aLeft.m_indexB != aRight.m_indexB )
+                       return aLeft.m_indexB < aRight.m_indexB;
+
+                   return aLeft.m_layer < aRight.m_layer;
+               } );
 
-                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + m_msg );
-                        drce->SetViolatingRule( constraint.GetParentRule() );
-                    }
+    // The rules and polygon collisions of the candidate pairs are evaluated in parallel
+    std::atomic<size_t> nextPair( 0 );
+    std::atomic<size_t> pairsDone( 0 );
+    std::atomic<bool>   cancelled( false );
 
-                    drce->SetItems( footprint, test );
-                    reportViolation( drce, (wxPoint) pos );
+    auto collide_lambda =
+            [&]()
+            {
+                for( size_t i = nextPair.fetch_add( 1 ); i < pairs.size() && !cancelled;
+                     i = nextPair.fetch_add( 1 ) )
+                {
+                    COURTYARD_PAIR&       pair = pairs[i];
+                    const SHAPE_POLY_SET& courtyardA =
+                            pair.m_layer == F_Cu ? pair.m_footprintA->GetPolyCourtyardFront()
+                                                 : pair.m_footprintA->GetPolyCourtyardBack();
+                    const SHAPE_POLY_SET& courtyardB =
+                            pair.m_layer == F_Cu ? pair.m_footprintB->GetPolyCourtyardFront()
+                                                 : pair.m_footprintB->GetPolyCourtyardBack();
+
+                    pair.m_constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT,
+                                                                pair.m_footprintA,
+                                                                pair.m_footprintB, pair.m_layer );
+                    pair.m_clearance = pair.m_constraint.GetValue().Min();
+
+                    pair.m_collides = pair.m_clearance >= 0
+                                      && courtyardA.Collide( &courtyardB, pair.m_clearance,
+                                                             &pair.m_actual, &pair.m_pos );
+
+                    pairsDone.fetch_add( 1 );
                 }
-            }
+            };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   pairs.size() );
 
-            if( footprintBack.OutlineCount() > 0 && testBack.OutlineCount() > 0
-                    && backBBox.Intersects( testBack.BBoxFromCaches() ) )
+    if( parallelThreadCount <= 1 )
+    {
+        collide_lambda();
+    }
+    else
+    {
+        std::vector<std::future<void>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, collide_lambda );
+
+        for( const std::future<void>& ret : returns )
+        {
+            std::future_status status;
+
+            do
             {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, footprint,
-                                                     test, B_Cu );
-                clearance = constraint.GetValue().Min();
+                if( !m_drcEngine->ReportProgress( (double) pairsDone / (double) pairs.size() ) )
+                    cancelled = true;
 
-                if( clearance >= 0 && footprintBack.Collide( &testBack, clearance, &actual, &pos ) )
-                {
-                    std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+                status = ret.wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
+        }
+    }
 
-                    if( clearance > 0 )
-                    {
-                        m_msg.Printf( _( "(%s clearance %s; actual %s)" ),
-                                      constraint.GetName(),
-                                      MessageTextFromValue( userUnits(), clearance ),
-                                      MessageTextFromValue( userUnits(), actual ) );
+    if( cancelled )
+        return false;   // DRC cancelled
 
-                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + m_msg );
-                        drce->SetViolatingRule( constraint.GetParentRule() );
-                    }
+    for( const COURTYARD_PAIR& pair : pairs )
+    {
+        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS) )
+            break;
 
-                    drce->SetItems( footprint, test );
-                    reportViolation( drce, (wxPoint) pos );
-                }
-            }
+        if( !pair.m_collides )
+            continue;
+
+        std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+
+        if( pair.m_clearance > 0 )
+        {
+            m_msg.Printf( _( "(%s clearance %s; actual %s)" ),
+                          pair.m_constraint.GetName(),
+                          MessageTextFromValue( userUnits(), pair.m_clearance ),
+                          MessageTextFromValue( userUnits(), pair.m_actual ) );
+
+            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + m_msg );
+            drce->SetViolatingRule( pair.m_constraint.GetParentRule() );
         }
+
+        drce->SetItems( pair.m_footprintA, pair.m_footprintB );
+        reportViolation( drce, (wxPoint) pair.m_pos );
     }
 
     return true;
@@ -341,8 +341,10 @@ bool test::DRC_TEST_PROVIDER_DIFF_PAIR_COUPLING::Run()
                 return true;
             };
 
+    copperTree.BeginBulkLoad();
     forEachGeometryItem( { PCB_TRACE_T, PCB_VIA_T, PCB_PAD_T, PCB_ZONE_T, PCB_ARC_T },
                          LSET::AllCuMask(), addToTree );
+    copperTree.EndBulkLoad();
 
 
     reportAux( wxString::Format( _("DPs evaluated:") ) );
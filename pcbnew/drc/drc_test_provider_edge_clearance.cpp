@@ -207,6 +207,8 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                          queryBoardOutlineItems );
     forEachGeometryItem( s_allBasicItemsButZones, LSET::AllCuMask(), queryBoardGeometryItems );
 
+    edgesTree.BeginBulkLoad();
+
     for( const std::unique_ptr<PCB_SHAPE>& edge : edges )
     {
         for( PCB_LAYER_ID layer : { Edge_Cuts, Margin } )
@@ -216,6 +218,8 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
         }
     }
 
+    edgesTree.EndBulkLoad();
+
     wxString val;
     wxGetEnv( "WXTRACE", &val );
 
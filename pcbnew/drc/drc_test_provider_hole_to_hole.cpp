@@ -172,7 +172,9 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
 
     count *= 2;  // One for adding to tree; one for checking
 
+    m_holeTree.BeginBulkLoad();
     forEachGeometryItem( { PCB_PAD_T, PCB_VIA_T }, LSET::AllLayersMask(), addToHoleTree );
+    m_holeTree.EndBulkLoad();
 
     std::map< std::pair<BOARD_ITEM*, BOARD_ITEM*>, int> checkedPairs;
 
@@ -206,16 +206,21 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                 return true;
             };
 
+    silkTree.BeginBulkLoad();
     forEachGeometryItem( s_allBasicItems, LSET( 2, F_SilkS, B_SilkS ), addToSilkTree );
+    silkTree.EndBulkLoad();
+
     forEachGeometryItem( s_allBasicItems,
                          LSET::FrontMask() | LSET::BackMask() | LSET( 2, Edge_Cuts, Margin ),
                          countTargets );
 
     targets *= 2;  // One for adding to RTree; one for testing
 
+    targetTree.BeginBulkLoad();
     forEachGeometryItem( s_allBasicItems,
                          LSET::FrontMask() | LSET::BackMask() | LSET( 2, Edge_Cuts, Margin ),
                          addToTargetTree );
+    targetTree.EndBulkLoad();
 
     reportAux( _("Testing %d silkscreen features against %d board items."),
                silkTree.size(),
@@ -176,9 +176,15 @@ bool DRC_TEST_PROVIDER_SILK_TO_MASK::Run()
                 return true;
             };
 
+    maskTree.BeginBulkLoad();
+    silkTree.BeginBulkLoad();
+
     int numMask = forEachGeometryItem( s_allBasicItems, LSET( 2, F_Mask, B_Mask ), addMaskToTree );
     int numSilk = forEachGeometryItem( s_allBasicItems, LSET( 2, F_SilkS, B_SilkS ), addSilkToTree );
 
+    maskTree.EndBulkLoad();
+    silkTree.EndBulkLoad();
+
     reportAux( _("Testing %d mask apertures against %d silkscreen features."), numMask, numSilk );
 
     const std::vector<DRC_RTREE::LAYER_PAIR> layerPairs =
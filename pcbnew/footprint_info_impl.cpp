@@ -45,7 +45,16 @@ void FOOTPRINT_INFO_IMPL::load()
 
     wxASSERT( fptable );
 
-    const FOOTPRINT* footprint = fptable->GetEnumeratedFootprint( m_nickname, m_fpname );
+    const FOOTPRINT* footprint = nullptr;
+
+    try
+    {
+        footprint = fptable->GetEnumeratedFootprint( m_nickname, m_fpname );
+    }
+    catch( const IO_ERROR& )
+    {
+        // The error was already reported when the library was listed
+    }
 
     if( footprint == NULL ) // Should happen only with malformed/broken libraries
     {
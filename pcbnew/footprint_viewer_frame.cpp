@@ -1025,11 +1025,23 @@ void FOOTPRINT_VIEWER_FRAME::SelectAndViewFootprint( int aMode )
         // Delete the current footprint
         GetBoard()->DeleteAllFootprints();
 
-        FOOTPRINT* footprint = Prj().PcbFootprintLibs()->FootprintLoad( getCurNickname(),
-                                                                        getCurFootprintName() );
+        try
+        {
+            FOOTPRINT* footprint = Prj().PcbFootprintLibs()->FootprintLoad( getCurNickname(),
+                                                                            getCurFootprintName() );
 
-        if( footprint )
-            GetBoard()->Add( footprint, ADD_MODE::APPEND );
+            if( footprint )
+                GetBoard()->Add( footprint, ADD_MODE::APPEND );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxString msg = wxString::Format( _( "Could not load footprint '%s' from library '%s'."
+                                                "\n\n%s" ),
+                                             getCurFootprintName(),
+                                             getCurNickname(),
+                                             ioe.Problem() );
+            DisplayError( this, msg );
+        }
 
         Update3DView( true, true );
 
@@ -23,6 +23,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <unordered_map>
+
 #include <reporter.h>
 #include <board_commit.h>
 #include <cleanup_item.h>
@@ -136,10 +138,14 @@ bool GRAPHICS_CLEANER::areEquivalent( PCB_SHAPE* aShape1, PCB_SHAPE* aShape2 )
 
 void GRAPHICS_CLEANER::cleanupSegments()
 {
+    // Segments kept so far, indexed by their start point.  Equivalent segments share their
+    // start point, so each segment is only compared with the few others starting there.
+    std::unordered_map<wxPoint, std::vector<PCB_SHAPE*>> segmentsByStart;
+
     // Remove duplicate segments (2 superimposed identical segments):
-    for( auto it = m_drawings.begin(); it != m_drawings.end(); it++ )
+    for( BOARD_ITEM* drawing : m_drawings )
     {
-        PCB_SHAPE* segment = dynamic_cast<PCB_SHAPE*>( *it );
+        PCB_SHAPE* segment = dynamic_cast<PCB_SHAPE*>( drawing );
 
         if( !segment || segment->GetShape() != PCB_SHAPE_TYPE::SEGMENT
             || segment->HasFlag( IS_DELETED ) )
@@ -157,25 +163,32 @@ void GRAPHICS_CLEANER::cleanupSegments()
             continue;
         }
 
-        for( auto it2 = it + 1; it2 != m_drawings.end(); it2++ )
+        std::vector<PCB_SHAPE*>& candidates = segmentsByStart[ segment->GetStart() ];
+        bool                     duplicate = false;
+
+        for( PCB_SHAPE* candidate : candidates )
         {
-            PCB_SHAPE* segment2 = dynamic_cast<PCB_SHAPE*>( *it2 );
+            if( areEquivalent( candidate, segment ) )
+            {
+                duplicate = true;
+                break;
+            }
+        }
 
-            if( !segment2 || segment2->HasFlag( IS_DELETED ) )
-                continue;
+        if( !duplicate )
+        {
+            candidates.push_back( segment );
+            continue;
+        }
 
-            if( areEquivalent( segment, segment2 ) )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_GRAPHIC );
-                item->SetItems( segment2 );
-                m_itemsList->push_back( item );
+        std::shared_ptr<CLEANUP_ITEM> item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_GRAPHIC );
+        item->SetItems( segment );
+        m_itemsList->push_back( item );
 
-                segment2->SetFlags( IS_DELETED );
+        segment->SetFlags( IS_DELETED );
 
-                if( !m_dryRun )
-                    m_commit.Removed( segment2 );
-            }
-        }
+        if( !m_dryRun )
+            m_commit.Removed( segment );
     }
 }
 
@@ -199,7 +212,7 @@ void GRAPHICS_CLEANER::mergeRects()
     };
 
     std::vector<SIDE_CANDIDATE*> sides;
-    std::map<wxPoint, std::vector<SIDE_CANDIDATE*>> ptMap;
+    std::unordered_map<wxPoint, std::vector<SIDE_CANDIDATE*>> ptMap;
 
     // First load all the candidates into the side vector and layer maps
     for( BOARD_ITEM* item : m_drawings )
@@ -216,6 +229,15 @@ void GRAPHICS_CLEANER::mergeRects()
         }
     }
 
+    static const std::vector<SIDE_CANDIDATE*> noSides;
+
+    auto sidesAt =
+            [&]( const wxPoint& aPoint ) -> const std::vector<SIDE_CANDIDATE*>&
+            {
+                auto it = ptMap.find( aPoint );
+                return it != ptMap.end() ? it->second : noSides;
+            };
+
     // Now go through the sides and try and match lines into rectangles
     for( SIDE_CANDIDATE* side : sides )
     {
@@ -240,7 +262,7 @@ void GRAPHICS_CLEANER::mergeRects()
             //
             left = side;
 
-            for( SIDE_CANDIDATE* candidate : ptMap[ left->start ] )
+            for( SIDE_CANDIDATE* candidate : sidesAt( left->start ) )
             {
                 if( candidate != left && viable( candidate ) )
                 {
@@ -255,7 +277,7 @@ void GRAPHICS_CLEANER::mergeRects()
             //
             top = side;
 
-            for( SIDE_CANDIDATE* candidate : ptMap[ top->start ] )
+            for( SIDE_CANDIDATE* candidate : sidesAt( top->start ) )
             {
                 if( candidate != top && viable( candidate ) )
                 {
@@ -269,7 +291,7 @@ void GRAPHICS_CLEANER::mergeRects()
         {
             // See if we can fill in the other two sides
             //
-            for( SIDE_CANDIDATE* candidate : ptMap[ top->end ] )
+            for( SIDE_CANDIDATE* candidate : sidesAt( top->end ) )
             {
                 if( candidate != top && viable( candidate ) )
                 {
@@ -278,7 +300,7 @@ void GRAPHICS_CLEANER::mergeRects()
                 }
             }
 
-            for( SIDE_CANDIDATE* candidate : ptMap[ left->end ] )
+            for( SIDE_CANDIDATE* candidate : sidesAt( left->end ) )
             {
                 if( candidate != left && viable( candidate ) )
                 {
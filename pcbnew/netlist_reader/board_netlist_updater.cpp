@@ -27,7 +27,12 @@
  */
 
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <common.h>                         // for PAGE_INFO
+#include <hashtables.h>
 
 #include <board.h>
 #include <netinfo.h>
@@ -409,10 +414,22 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
     FOOTPRINT* copy = m_commit.GetStatus( aFootprint ) ? nullptr : (FOOTPRINT*) aFootprint->Clone();
     bool       changed = false;
 
+    static const COMPONENT_NET noNet;
+
+    // Index the component nets by pin name once, instead of searching them for every pad
+    std::unordered_map<wxString, const COMPONENT_NET*, WXSTRING_HASH> netsByPin;
+
+    for( unsigned ii = 0; ii < aNewComponent->GetNetCount(); ii++ )
+    {
+        const COMPONENT_NET& net = aNewComponent->GetNet( ii );
+        netsByPin.emplace( net.GetPinName(), &net );
+    }
+
     // At this point, the component footprint is updated.  Now update the nets.
     for( PAD* pad : aFootprint->Pads() )
     {
-        const COMPONENT_NET& net = aNewComponent->GetNet( pad->GetName() );
+        auto                 netIt = netsByPin.find( pad->GetName() );
+        const COMPONENT_NET& net = netIt != netsByPin.end() ? *netIt->second : noNet;
 
         wxString pinFunction;
         wxString pinType;
@@ -878,13 +895,18 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
         if( !footprint )    // It can be missing in partial designs
             continue;
 
+        std::unordered_set<wxString, WXSTRING_HASH> padNames;
+
+        for( PAD* pad : footprint->Pads() )
+            padNames.insert( pad->GetName() );
+
         // Explore all pins/pads in component
         for( unsigned jj = 0; jj < component->GetNetCount(); jj++ )
         {
             const COMPONENT_NET& net = component->GetNet( jj );
             padname = net.GetPinName();
 
-            if( footprint->FindPadByName( padname ) )
+            if( padNames.count( padname ) )
                 continue;   // OK, pad found
 
             // not found: bad footprint, report error
@@ -903,7 +925,6 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
 
 bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 {
-    FOOTPRINT* lastPreexistingFootprint = nullptr;
     COMPONENT* component = nullptr;
     wxString   msg;
 
@@ -913,8 +934,22 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     std::map<COMPONENT*, FOOTPRINT*> footprintMap;
 
-    if( !m_board->Footprints().empty() )
-        lastPreexistingFootprint = m_board->Footprints().back();
+    // Index the footprints already on the board by path or by reference, so that matching a
+    // component doesn't need a scan of all the footprints.  Footprints are referred to by
+    // their index in the board list, so matches can be visited in board order.
+    std::vector<FOOTPRINT*> boardFootprints( m_board->Footprints().begin(),
+                                             m_board->Footprints().end() );
+
+    std::unordered_map<KIID_PATH, std::vector<size_t>, KIID_PATH_HASH> footprintsByPath;
+    std::unordered_map<wxString, std::vector<size_t>, WXSTRING_HASH>   footprintsByReference;
+
+    for( size_t ii = 0; ii < boardFootprints.size(); ++ii )
+    {
+        if( m_lookupByTimestamp )
+            footprintsByPath[ boardFootprints[ii]->GetPath() ].push_back( ii );
+        else
+            footprintsByReference[ boardFootprints[ii]->GetReference().Lower() ].push_back( ii );
+    }
 
     cacheCopperZoneConnections();
 
@@ -944,54 +979,54 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
                     component->GetFPID().Format().wx_str() );
         m_reporter->Report( msg, RPT_SEVERITY_INFO );
 
-        int matchCount = 0;
+        std::vector<size_t> matches;
 
-        for( FOOTPRINT* footprint : m_board->Footprints() )
+        if( m_lookupByTimestamp )
         {
-            bool match = false;
+            KIID_PATH path = component->GetPath();
 
-            if( m_lookupByTimestamp )
+            for( const KIID& uuid : component->GetKIIDs() )
             {
-                for( const KIID& uuid : component->GetKIIDs() )
-                {
-                    KIID_PATH base = component->GetPath();
-                    base.push_back( uuid );
+                path.push_back( uuid );
 
-                    if( footprint->GetPath() == base )
-                    {
-                        match = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
+                auto it = footprintsByPath.find( path );
+
+                if( it != footprintsByPath.end() )
+                    matches.insert( matches.end(), it->second.begin(), it->second.end() );
+
+                path.pop_back();
             }
 
-            if( match )
-            {
-                FOOTPRINT* tmp = footprint;
+            std::sort( matches.begin(), matches.end() );
+            matches.erase( std::unique( matches.begin(), matches.end() ), matches.end() );
+        }
+        else
+        {
+            auto it = footprintsByReference.find( component->GetReference().Lower() );
 
-                if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
-                    tmp = replaceFootprint( aNetlist, footprint, component );
+            if( it != footprintsByReference.end() )
+                matches = it->second;
+        }
 
-                if( tmp )
-                {
-                    footprintMap[ component ] = tmp;
+        int matchCount = 0;
 
-                    updateFootprintParameters( tmp, component );
-                    updateComponentPadConnections( tmp, component );
-                }
+        for( size_t index : matches )
+        {
+            FOOTPRINT* footprint = boardFootprints[ index ];
+            FOOTPRINT* tmp = footprint;
 
-                matchCount++;
-            }
+            if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
+                tmp = replaceFootprint( aNetlist, footprint, component );
 
-            if( footprint == lastPreexistingFootprint )
+            if( tmp )
             {
-                // No sense going through the newly-created footprints: end of loop
-                break;
+                footprintMap[ component ] = tmp;
+
+                updateFootprintParameters( tmp, component );
+                updateComponentPadConnections( tmp, component );
             }
+
+            matchCount++;
         }
 
         if( matchCount == 0 )
@@ -1016,6 +1051,31 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     updateCopperZoneNets( aNetlist );
 
+    // Index the components the same way as the netlist lookups do: the first component wins.
+    std::unordered_map<KIID_PATH, COMPONENT*, KIID_PATH_HASH> componentsByPath;
+    std::unordered_map<wxString, COMPONENT*, WXSTRING_HASH>   componentsByReference;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( m_lookupByTimestamp )
+        {
+            KIID_PATH path = component->GetPath();
+
+            for( const KIID& uuid : component->GetKIIDs() )
+            {
+                path.push_back( uuid );
+                componentsByPath.emplace( path, component );
+                path.pop_back();
+            }
+        }
+        else
+        {
+            componentsByReference.emplace( component->GetReference(), component );
+        }
+    }
+
     // Finally go through the board footprints and update all those that *don't* have matching
     // component entries.
     //
@@ -1027,10 +1087,22 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         if( ( footprint->GetAttributes() & FP_BOARD_ONLY ) > 0 )
             doDelete = false;
 
+        component = nullptr;
+
         if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByPath( footprint->GetPath() );
+        {
+            auto it = componentsByPath.find( footprint->GetPath() );
+
+            if( it != componentsByPath.end() )
+                component = it->second;
+        }
         else
-            component = aNetlist.GetComponentByReference( footprint->GetReference() );
+        {
+            auto it = componentsByReference.find( footprint->GetReference() );
+
+            if( it != componentsByReference.end() )
+                component = it->second;
+        }
 
         if( component && component->GetProperties().count( "exclude_from_board" ) == 0 )
             matched = true;
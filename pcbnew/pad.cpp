@@ -1338,6 +1338,16 @@ const BOX2I PAD::ViewBBox() const
 }
 
 
+void PAD::ViewPrepareDraw()
+{
+    if( m_shapesDirty )
+        BuildEffectiveShapes( UNDEFINED_LAYER );
+
+    if( m_polyDirty )
+        BuildEffectivePolygon();
+}
+
+
 FOOTPRINT* PAD::GetParent() const
 {
     return dynamic_cast<FOOTPRINT*>( m_parent );
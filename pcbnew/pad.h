@@ -659,6 +659,8 @@ public:
 
     virtual const BOX2I ViewBBox() const override;
 
+    void ViewPrepareDraw() override;
+
     virtual void SwapData( BOARD_ITEM* aImage ) override;
 
 #if defined(DEBUG)
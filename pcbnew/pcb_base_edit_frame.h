@@ -28,6 +28,7 @@
 #define BASE_EDIT_FRAME_H
 
 #include <pcb_base_frame.h>
+#include <undo_item_copies.h>
 
 class APPEARANCE_CONTROLS;
 class BOARD_ITEM_CONTAINER;
@@ -180,9 +181,18 @@ public:
     /* full undo redo management : */
 
     // use EDA_BASE_FRAME::ClearUndoRedoList()
-    // use EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
     // use EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
 
+    /**
+     * Add a command to the undo list.
+     *
+     * The oldest commands are dropped once the undo list holds more item copies than the
+     * UndoItemBudget advanced config entry allows; the new command is always kept.
+     */
+    void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem ) override;
+
+    PICKED_ITEMS_LIST* PopCommandFromUndoList() override;
+
     /**
      * Free the undo or redo list from List element.
      *
@@ -234,6 +244,9 @@ protected:
     int                     m_rotationAngle;        // Rotation step (in tenths of a degree)
     bool                    m_undoRedoBlocked;
 
+    ///< Number of item copies held by the commands of the undo list
+    UNDO_ITEM_COPIES        m_undoItemCopies;
+
     PANEL_SELECTION_FILTER* m_selectionFilterPanel;
     APPEARANCE_CONTROLS*    m_appearancePanel;
 };
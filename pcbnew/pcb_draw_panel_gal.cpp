@@ -47,8 +47,8 @@
 #include <zoom_defines.h>
 
 #include <functional>
+#include <future>
 #include <memory>
-#include <thread>
 
 using namespace std::placeholders;
 
@@ -137,6 +137,11 @@ const LAYER_NUM GAL_LAYER_ORDER[] =
 };
 
 
+/// Scale below which the copper layers are drawn from aggregated drawings, where a millimeter
+/// spans about 3.5 pixels on a standard DPI screen.
+static const double LOD_SCALE_THRESHOLD = 1.0;
+
+
 PCB_DRAW_PANEL_GAL::PCB_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindowId,
                                         const wxPoint& aPosition, const wxSize& aSize,
                                         KIGFX::GAL_DISPLAY_OPTIONS& aOptions, GAL_TYPE aGalType ) :
@@ -181,27 +186,20 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
 
     m_view->Clear();
 
-    auto zones = aBoard->Zones();
-    std::atomic<size_t> next( 0 );
-    std::atomic<size_t> count_done( 0 );
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-    {
-        std::thread t = std::thread( [ &count_done, &next, &zones ]( )
-        {
-            for( size_t i = next.fetch_add( 1 ); i < zones.size(); i = next.fetch_add( 1 ) )
-                zones[i]->CacheTriangulation();
-
-            count_done++;
-        } );
-
-        t.detach();
-    }
+    // Triangulate the zones while the other items are loaded.  The polygons of large zones
+    // are triangulated in parallel.
+    std::future<void> triangulation = std::async( std::launch::async,
+            [aBoard]()
+            {
+                for( ZONE* zone : aBoard->Zones() )
+                    zone->CacheTriangulation( UNDEFINED_LAYER, true );
+            } );
 
     if( m_drawingSheet )
         m_drawingSheet->SetFileName( TO_UTF8( aBoard->GetFileName() ) );
 
+    m_view->BeginBulkLoad();
+
     // Load drawings
     for( BOARD_ITEM* drawing : aBoard->Drawings() )
         m_view->Add( drawing );
@@ -218,9 +216,8 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
     for( PCB_MARKER* marker : aBoard->Markers() )
         m_view->Add( marker );
 
-    // Finalize the triangulation threads
-    while( count_done < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    // Finalize the triangulation
+    triangulation.wait();
 
     // Load zones
     for( ZONE* zone : aBoard->Zones() )
@@ -229,6 +226,8 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
     // Ratsnest
     m_ratsnest = std::make_unique<RATSNEST_VIEW_ITEM>( aBoard->GetConnectivity() );
     m_view->Add( m_ratsnest.get() );
+
+    m_view->EndBulkLoad();
 }
 
 
@@ -621,6 +620,23 @@ void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
     m_view->SetLayerTarget( LAYER_DRAWINGSHEET, KIGFX::TARGET_NONCACHED );
     m_view->SetLayerDisplayOnly( LAYER_DRAWINGSHEET ) ;
     m_view->SetLayerDisplayOnly( LAYER_GRID );
+
+    // When zoomed out, copper items are drawn from aggregated, simplified drawings
+    for( PCB_LAYER_ID layer : LSET::AllCuMask().Seq() )
+    {
+        m_view->SetLayerAggregated( layer );
+        m_view->SetLayerAggregated( ZONE_LAYER_FOR( layer ) );
+    }
+
+    for( int layer : { LAYER_PADS_TH, LAYER_PAD_FR, LAYER_PAD_BK, LAYER_PAD_PLATEDHOLES,
+                       LAYER_PAD_HOLEWALLS, LAYER_NON_PLATEDHOLES, LAYER_VIA_THROUGH,
+                       LAYER_VIA_BBLIND, LAYER_VIA_MICROVIA, LAYER_VIA_HOLES,
+                       LAYER_VIA_HOLEWALLS } )
+    {
+        m_view->SetLayerAggregated( layer );
+    }
+
+    m_view->SetLODThreshold( LOD_SCALE_THRESHOLD, Millimeter2iu( 20 ) );
 }
 
 
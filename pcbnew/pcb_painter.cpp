@@ -568,6 +568,138 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+bool PCB_PAINTER::DrawLOD( const VIEW_ITEM* aItem, int aLayer )
+{
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return false;
+
+    // Details smaller than this are not visible at the scales using the simplified drawings
+    const int maxError = Millimeter2iu( 0.1 );
+
+    switch( item->Type() )
+    {
+    case PCB_TRACE_T:
+    {
+        const PCB_TRACK* track = static_cast<const PCB_TRACK*>( item );
+
+        if( !IsCopperLayer( aLayer ) || m_pcbSettings.m_sketchMode[LAYER_TRACKS] )
+            return false;
+
+        // Without clearance outlines
+        COLOR4D color = m_pcbSettings.GetColor( track, aLayer );
+
+        m_gal->SetFillColor( color );
+        m_gal->SetIsFill( true );
+        m_gal->SetIsStroke( false );
+        m_gal->DrawSegment( track->GetStart(), track->GetEnd(), track->GetWidth() );
+        return true;
+    }
+
+    case PCB_PAD_T:
+    {
+        const PAD* pad = static_cast<const PAD*>( item );
+
+        if( ( aLayer != LAYER_PADS_TH && aLayer != LAYER_PAD_FR && aLayer != LAYER_PAD_BK )
+                || m_pcbSettings.m_sketchMode[LAYER_PADS_TH] )
+        {
+            return false;
+        }
+
+        // The pad shape, without hole or clearance
+        COLOR4D color = m_pcbSettings.GetColor( pad, aLayer );
+
+        m_gal->SetFillColor( color );
+        m_gal->SetIsFill( true );
+        m_gal->SetIsStroke( false );
+
+        std::shared_ptr<SHAPE_COMPOUND> shapes =
+                std::dynamic_pointer_cast<SHAPE_COMPOUND>( pad->GetEffectiveShape() );
+
+        if( shapes && shapes->Size() == 1 && shapes->Shapes()[0]->Type() == SH_CIRCLE )
+        {
+            const SHAPE_CIRCLE* circle = (const SHAPE_CIRCLE*) shapes->Shapes()[0];
+            m_gal->DrawCircle( circle->GetCenter(), circle->GetRadius() );
+        }
+        else if( shapes && shapes->Size() == 1 && shapes->Shapes()[0]->Type() == SH_SEGMENT )
+        {
+            const SHAPE_SEGMENT* seg = (const SHAPE_SEGMENT*) shapes->Shapes()[0];
+            m_gal->DrawSegment( seg->GetSeg().A, seg->GetSeg().B, seg->GetWidth() );
+        }
+        else
+        {
+            m_gal->DrawPolygon( *pad->GetEffectivePolygon() );
+        }
+
+        return true;
+    }
+
+    case PCB_ZONE_T:
+    case PCB_FP_ZONE_T:
+    {
+        const ZONE*  zone = static_cast<const ZONE*>( item );
+        PCB_LAYER_ID layer = static_cast<PCB_LAYER_ID>( aLayer - LAYER_ZONE_START );
+
+        if( !IsZoneLayer( aLayer ) || !zone->IsOnLayer( layer )
+                || m_pcbSettings.m_zoneDisplayMode != ZONE_DISPLAY_MODE::SHOW_FILLED )
+        {
+            return false;
+        }
+
+        // The fill with fewer vertices, and without its outline
+        const SHAPE_POLY_SET& polySet = zone->GetFilledPolysList( layer );
+        SHAPE_POLY_SET        simplified;
+
+        for( int ii = 0; ii < polySet.OutlineCount(); ++ii )
+        {
+            const SHAPE_LINE_CHAIN& outline = polySet.COutline( ii );
+            SHAPE_LINE_CHAIN        decimated;
+
+            for( int jj = 0; jj < outline.PointCount(); ++jj )
+            {
+                const VECTOR2I& pt = outline.CPoint( jj );
+
+                if( decimated.PointCount() == 0
+                        || ( pt - decimated.CLastPoint() ).EuclideanNorm() >= maxError )
+                {
+                    decimated.Append( pt );
+                }
+            }
+
+            // Keep the small islands as they were
+            if( decimated.PointCount() < 3 )
+                decimated = outline;
+
+            decimated.SetClosed( true );
+            simplified.AddOutline( decimated );
+        }
+
+        if( simplified.OutlineCount() == 0 )
+            return true;
+
+        // Dropping vertices can make an outline cross itself or a neighbour, which the
+        // triangulation does not handle.  Fracture() merges the outlines back into valid ones.
+        simplified.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        if( m_gal->IsOpenGlEngine() )
+            simplified.CacheTriangulation();
+
+        COLOR4D color = m_pcbSettings.GetColor( zone, layer );
+
+        m_gal->SetFillColor( color );
+        m_gal->SetIsFill( true );
+        m_gal->SetIsStroke( false );
+        m_gal->DrawPolygon( simplified );
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+
 void PCB_PAINTER::draw( const PCB_TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
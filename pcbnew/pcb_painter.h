@@ -252,6 +252,9 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::DrawLOD()
+    virtual bool DrawLOD( const VIEW_ITEM* aItem, int aLayer ) override;
+
 protected:
     // Drawing functions for various types of PCB-specific items
     void draw( const PCB_TRACK* aTrack, int aLayer );
@@ -1222,6 +1222,14 @@ std::shared_ptr<SHAPE> PCB_SHAPE::GetEffectiveShape( PCB_LAYER_ID aLayer ) const
 }
 
 
+void PCB_SHAPE::ViewPrepareDraw()
+{
+    // Filled polygons are drawn from their triangulation
+    if( m_shape == PCB_SHAPE_TYPE::POLYGON && IsFilled() && m_poly.OutlineCount() )
+        m_poly.CacheTriangulation();
+}
+
+
 const std::vector<wxPoint> PCB_SHAPE::BuildPolyPointsList() const
 {
     std::vector<wxPoint> rv;
@@ -271,6 +271,8 @@ public:
     std::vector<SHAPE*> MakeEffectiveShapes() const; // fixme: move to shape_compound
     std::shared_ptr<SHAPE> GetEffectiveShape( PCB_LAYER_ID aLayer = UNDEFINED_LAYER ) const override;
 
+    void ViewPrepareDraw() override;
+
     void GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>& aList ) override;
 
     const EDA_RECT GetBoundingBox() const override;
@@ -55,6 +55,8 @@
 #include <zone.h>
 #include <zones.h>
 
+#include <set>
+
 using namespace PCB_KEYS_T;
 
 
@@ -69,19 +71,31 @@ using namespace PCB_KEYS_T;
 class FP_CACHE_ITEM
 {
     WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    std::unique_ptr<FOOTPRINT> m_footprint;     // nullptr until the file is parsed.
+    long long                  m_timestamp;     // Timestamp of the file when it was parsed.
+    wxString                   m_error;         // Parse error, if the file failed to parse.
 
 public:
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
+    WX_FILENAME& GetFileName() { return m_filename; }
     const WX_FILENAME& GetFileName() const { return m_filename; }
     const FOOTPRINT* GetFootprint()  const { return m_footprint.get(); }
+
+    void SetFootprint( FOOTPRINT* aFootprint ) { m_footprint.reset( aFootprint ); }
+
+    long long GetTimestamp() const { return m_timestamp; }
+    void SetTimestamp( long long aTimestamp ) { m_timestamp = aTimestamp; }
+
+    const wxString& GetError() const { return m_error; }
+    void SetError( const wxString& aError ) { m_error = aError; }
 };
 
 
 FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_timestamp( 0 )
 { }
 
 
@@ -122,8 +136,35 @@ public:
      */
     void Save( FOOTPRINT* aFootprint = nullptr );
 
+    /**
+     * Update the list of footprints from the library directory listing.
+     *
+     * Footprint files are not parsed here.  Footprints already parsed are kept unless their
+     * file changed since, so this is also used to refresh a modified cache.
+     */
     void Load();
 
+    /**
+     * Parse the file of \a aItem if it has not been parsed yet.
+     *
+     * A file which failed to parse is not parsed again until it changes; its error is thrown
+     * again instead.
+     *
+     * @throw IO_ERROR if the file cannot be read or parsed.
+     */
+    void ParseFootprint( FP_CACHE_ITEM* aItem );
+
+    /**
+     * Parse all of the footprint files not parsed yet.  Files which fail to parse keep their
+     * error, see GetErrors().
+     */
+    void ParseAll();
+
+    /**
+     * @return the errors of all of the files known to fail to parse, or an empty string.
+     */
+    wxString GetErrors() const;
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -181,6 +222,10 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 
     for( FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
+        // Footprints never parsed are unchanged on disk
+        if( !it->second->GetFootprint() )
+            continue;
+
         if( aFootprint && aFootprint != it->second->GetFootprint() )
             continue;
 
@@ -219,7 +264,8 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
             THROW_IO_ERROR( msg );
         }
 #endif
-        m_cache_timestamp += fn.GetTimestamp();
+        it->second->SetTimestamp( fn.GetTimestamp() );
+        m_cache_timestamp += it->second->GetTimestamp();
     }
 
     m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
@@ -251,44 +297,112 @@ void FP_CACHE::Load()
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
+    std::set<wxString> fpNames;
+
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
-
         do
         {
             fn.SetFullName( fullName );
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
-            {
-                FILE_LINE_READER    reader( fn.GetFullPath() );
-
-                m_owner->m_parser->SetLineReader( &reader );
+            wxString                fpName = fn.GetName();
+            FOOTPRINT_MAP::iterator it = m_footprints.find( fpName );
 
-                FOOTPRINT* footprint = (FOOTPRINT*) m_owner->m_parser->Parse();
-                wxString   fpName = fn.GetName();
+            fpNames.insert( fpName );
 
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
+            if( it == m_footprints.end() )
+            {
+                m_footprints.insert( fpName, new FP_CACHE_ITEM( nullptr, fn ) );
             }
-            catch( const IO_ERROR& ioe )
+            else if( ( it->second->GetFootprint() || !it->second->GetError().IsEmpty() )
+                     && it->second->GetFileName().GetTimestamp() != it->second->GetTimestamp() )
             {
-                if( !cacheError.IsEmpty() )
-                    cacheError += "\n\n";
-
-                cacheError += ioe.What();
+                // Only the files changed since they were parsed are invalidated
+                it->second->SetFootprint( nullptr );
+                it->second->SetError( wxEmptyString );
             }
         } while( dir.GetNext( &fullName ) );
+    }
+
+    for( FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); )
+    {
+        if( fpNames.count( it->first ) )
+            ++it;
+        else
+            it = m_footprints.erase( it );
+    }
+
+    m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+}
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
 
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+void FP_CACHE::ParseFootprint( FP_CACHE_ITEM* aItem )
+{
+    if( aItem->GetFootprint() )
+        return;
+
+    if( !aItem->GetError().IsEmpty() )
+        THROW_IO_ERROR( aItem->GetError() );
+
+    WX_FILENAME& fn = aItem->GetFileName();
+
+    // Timestamp the file before reading it so a concurrent change invalidates it later
+    aItem->SetTimestamp( fn.GetTimestamp() );
+
+    try
+    {
+        FILE_LINE_READER reader( fn.GetFullPath() );
+
+        m_owner->m_parser->SetLineReader( &reader );
+
+        FOOTPRINT* footprint = (FOOTPRINT*) m_owner->m_parser->Parse();
+
+        footprint->SetFPID( LIB_ID( wxEmptyString, fn.GetName() ) );
+        aItem->SetFootprint( footprint );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        aItem->SetError( ioe.What() );
+        throw;
     }
 }
 
 
+void FP_CACHE::ParseAll()
+{
+    for( FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
+    {
+        // Errors are kept by each item, so only files that fail to parse don't get loaded.
+        try
+        {
+            ParseFootprint( it->second );
+        }
+        catch( const IO_ERROR& )
+        {
+        }
+    }
+}
+
+
+wxString FP_CACHE::GetErrors() const
+{
+    wxString errors;
+
+    for( FOOTPRINT_MAP::const_iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
+    {
+        if( it->second->GetError().IsEmpty() )
+            continue;
+
+        if( !errors.IsEmpty() )
+            errors += "\n\n";
+
+        errors += it->second->GetError();
+    }
+
+    return errors;
+}
+
+
 void FP_CACHE::Remove( const wxString& aFootprintName )
 {
     FOOTPRINT_MAP::const_iterator it = m_footprints.find( aFootprintName );
@@ -2313,13 +2427,17 @@ void PCB_IO::init( const PROPERTIES* aProperties )
 
 void PCB_IO::validateCache( const wxString& aLibraryPath, bool checkModified )
 {
-    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || ( checkModified && m_cache->IsModified() ) )
+    if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
     {
         // a spectacular episode in memory management:
         delete m_cache;
         m_cache = new FP_CACHE( this, aLibraryPath );
         m_cache->Load();
     }
+    else if( checkModified && m_cache->IsModified() )
+    {
+        m_cache->Load();
+    }
 }
 
 
@@ -2342,16 +2460,44 @@ void PCB_IO::FootprintEnumerate( wxArrayString& aFootprintNames, const wxString&
     }
 
     // Some of the files may have been parsed correctly so we want to add the valid files to
-    // the library.
+    // the library.  Files are only parsed on demand, so only the files already known to be
+    // broken are left out and reported.
 
     for( const auto& footprint : m_cache->GetFootprints() )
-        aFootprintNames.Add( footprint.first );
+    {
+        if( footprint.second->GetError().IsEmpty() )
+            aFootprintNames.Add( footprint.first );
+    }
+
+    wxString parseErrors = m_cache->GetErrors();
+
+    if( !parseErrors.IsEmpty() )
+    {
+        if( !errorMsg.IsEmpty() )
+            errorMsg += "\n\n";
+
+        errorMsg += parseErrors;
+    }
 
     if( !errorMsg.IsEmpty() && !aBestEfforts )
         THROW_IO_ERROR( errorMsg );
 }
 
 
+void PCB_IO::PrefetchLib( const wxString& aLibraryPath, const PROPERTIES* aProperties )
+{
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    validateCache( aLibraryPath );
+
+    // Parse errors are reported by FootprintEnumerate(), so that a library with a broken file
+    // still gets its valid footprints listed.
+    m_cache->ParseAll();
+}
+
+
 const FOOTPRINT* PCB_IO::getFootprint( const wxString& aLibraryPath,
                                        const wxString& aFootprintName,
                                        const PROPERTIES* aProperties,
@@ -2371,11 +2517,13 @@ const FOOTPRINT* PCB_IO::getFootprint( const wxString& aLibraryPath,
     }
 
     FOOTPRINT_MAP& footprints = m_cache->GetFootprints();
-    FOOTPRINT_MAP::const_iterator it = footprints.find( aFootprintName );
+    FOOTPRINT_MAP::iterator it = footprints.find( aFootprintName );
 
     if( it == footprints.end() )
         return nullptr;
 
+    m_cache->ParseFootprint( it->second );
+
     return it->second->GetFootprint();
 }
 
@@ -163,6 +163,9 @@ public:
     void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibraryPath,
                              bool aBestEfforts, const PROPERTIES* aProperties = nullptr ) override;
 
+    void PrefetchLib( const wxString& aLibraryPath,
+                      const PROPERTIES* aProperties = nullptr ) override;
+
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aLibraryPath,
                                              const wxString& aFootprintName,
                                              const PROPERTIES* aProperties = nullptr ) override;
@@ -23,6 +23,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <future>
+#include <thread>
+#include <unordered_map>
+
 #include <reporter.h>
 #include <board_commit.h>
 #include <cleanup_item.h>
@@ -270,123 +275,188 @@ void TRACKS_CLEANER::deleteTracksInPads()
 void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegments,
                               bool aDeleteDuplicateSegments, bool aMergeSegments )
 {
-    DRC_RTREE rtree;
+    std::vector<PCB_TRACK*>                       tracks;
+    std::unordered_map<const BOARD_ITEM*, size_t> trackIndex;
+
+    // The tracks are about to be merged or deleted: don't fill the board shape cache with them
+    DRC_RTREE rtree( false );
+
+    tracks.reserve( m_brd->Tracks().size() );
+    rtree.BeginBulkLoad();
 
     for( PCB_TRACK* track : m_brd->Tracks() )
     {
         track->ClearFlags( IS_DELETED | SKIP_STRUCT );
+
+        if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T && !track->IsLocked()
+                && track->GetStart() != track->GetEnd() )
+        {
+            track->SetEnd( track->GetStart() );
+        }
+
+        trackIndex[ track ] = tracks.size();
+        tracks.push_back( track );
         rtree.Insert( track, track->GetLayer() );
     }
 
-    std::set<BOARD_ITEM*> toRemove;
+    rtree.EndBulkLoad();
 
-    for( PCB_TRACK* track : m_brd->Tracks() )
+    // An unlocked track is redundant when it duplicates a track which comes after it, or a
+    // locked one: the last of a set of duplicates is the one which is kept.
+    auto supersedes =
+            [&]( PCB_TRACK* aTrack, BOARD_ITEM* aOther ) -> bool
+            {
+                return aOther->IsLocked() || trackIndex.at( aOther ) > trackIndex.at( aTrack );
+            };
+
+    struct FINDINGS
     {
-        if( track->HasFlag( IS_DELETED ) || track->IsLocked() )
-            continue;
+        int  duplicateVias   = 0;
+        PAD* throughPad      = nullptr;
+        bool nullSegment     = false;
+        int  duplicateTracks = 0;
+    };
 
-        if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T )
-        {
-            PCB_VIA* via = static_cast<PCB_VIA*>( track );
+    std::vector<FINDINGS>              findings( tracks.size() );
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
+    std::atomic<size_t>                nextTrack( 0 );
 
-            if( via->GetStart() != via->GetEnd() )
-                via->SetEnd( via->GetStart() );
+    // Find the redundant items in parallel; the board is only read here.
+    auto scan_lambda =
+            [&]()
+            {
+                for( size_t i = nextTrack.fetch_add( 1 ); i < tracks.size();
+                     i = nextTrack.fetch_add( 1 ) )
+                {
+                    PCB_TRACK* track = tracks[i];
+                    FINDINGS&  found = findings[i];
 
-            rtree.QueryColliding( via, via->GetLayer(), via->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_VIA_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED );
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        PCB_VIA* other = static_cast<PCB_VIA*>( aItem );
+                    if( track->IsLocked() )
+                        continue;
 
-                        if( via->GetPosition() == other->GetPosition()
-                                && via->GetViaType() == other->GetViaType()
-                                && via->GetLayerSet() == other->GetLayerSet() )
+                    if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T )
+                    {
+                        PCB_VIA* via = static_cast<PCB_VIA*>( track );
+
+                        rtree.QueryColliding( via, via->GetLayer(), via->GetLayer(),
+                                // Filter:
+                                [&]( BOARD_ITEM* aItem ) -> bool
+                                {
+                                    return aItem->Type() == PCB_VIA_T && supersedes( via, aItem );
+                                },
+                                // Visitor:
+                                [&]( BOARD_ITEM* aItem ) -> bool
+                                {
+                                    PCB_VIA* other = static_cast<PCB_VIA*>( aItem );
+
+                                    if( via->GetPosition() == other->GetPosition()
+                                            && via->GetViaType() == other->GetViaType()
+                                            && via->GetLayerSet() == other->GetLayerSet() )
+                                    {
+                                        found.duplicateVias++;
+                                    }
+
+                                    return true;
+                                } );
+
+                        // To delete through Via on THT pads at same location
+                        // Examine the list of connected pads: if a through pad is found, the via
+                        // is redundant
+                        for( PAD* pad : connectivity->GetConnectedPads( via ) )
                         {
-                            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_REDUNDANT_VIA );
-                            item->SetItems( via );
-                            m_itemsList->push_back( item );
+                            const LSET all_cu = LSET::AllCuMask();
 
-                            via->SetFlags( IS_DELETED );
-                            toRemove.insert( via );
+                            if( ( pad->GetLayerSet() & all_cu ) == all_cu )
+                            {
+                                found.throughPad = pad;
+                                break;
+                            }
                         }
+                    }
 
-                        return true;
-                    } );
+                    if( aDeleteNullSegments && track->Type() != PCB_VIA_T )
+                        found.nullSegment = track->IsNull();
 
-            // To delete through Via on THT pads at same location
-            // Examine the list of connected pads: if a through pad is found, the via is redundant
-            for( PAD* pad : m_brd->GetConnectivity()->GetConnectedPads( via ) )
-            {
-                const LSET all_cu = LSET::AllCuMask();
+                    if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T )
+                    {
+                        rtree.QueryColliding( track, track->GetLayer(), track->GetLayer(),
+                                // Filter:
+                                [&]( BOARD_ITEM* aItem ) -> bool
+                                {
+                                    return aItem->Type() == PCB_TRACE_T
+                                              && supersedes( track, aItem );
+                                },
+                                // Visitor:
+                                [&]( BOARD_ITEM* aItem ) -> bool
+                                {
+                                    PCB_TRACK* other = static_cast<PCB_TRACK*>( aItem );
+
+                                    if( track->IsPointOnEnds( other->GetStart() )
+                                            && track->IsPointOnEnds( other->GetEnd() )
+                                            && track->GetWidth() == other->GetWidth()
+                                            && track->GetLayer() == other->GetLayer() )
+                                    {
+                                        found.duplicateTracks++;
+                                    }
+
+                                    return true;
+                                } );
+                    }
+                }
+            };
 
-                if( ( pad->GetLayerSet() & all_cu ) == all_cu )
-                {
-                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_REDUNDANT_VIA );
-                    item->SetItems( via, pad );
-                    m_itemsList->push_back( item );
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   tracks.size() );
 
-                    via->SetFlags( IS_DELETED );
-                    toRemove.insert( via );
-                    break;
-                }
-            }
+    if( parallelThreadCount <= 1 )
+    {
+        scan_lambda();
+    }
+    else
+    {
+        std::vector<std::future<void>> returns( parallelThreadCount );
 
-            via->SetFlags( SKIP_STRUCT );
-        }
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, scan_lambda );
 
-        if( aDeleteNullSegments && track->Type() != PCB_VIA_T )
-        {
-            if( track->IsNull() )
+        for( const std::future<void>& ret : returns )
+            ret.wait();
+    }
+
+    // Report and remove the redundant items in board order
+    std::set<BOARD_ITEM*> toRemove;
+
+    auto markRedundant =
+            [&]( PCB_TRACK* aTrack, int aErrorCode, PAD* aPad = nullptr )
             {
-                auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_ZERO_LENGTH_TRACK );
-                item->SetItems( track );
+                auto item = std::make_shared<CLEANUP_ITEM>( aErrorCode );
+
+                if( aPad )
+                    item->SetItems( aTrack, aPad );
+                else
+                    item->SetItems( aTrack );
+
                 m_itemsList->push_back( item );
 
-                track->SetFlags( IS_DELETED );
-                toRemove.insert( track );
-            }
-        }
+                aTrack->SetFlags( IS_DELETED );
+                toRemove.insert( aTrack );
+            };
 
-        if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T )
-        {
-            rtree.QueryColliding( track, track->GetLayer(), track->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_TRACE_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED );
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        PCB_TRACK* other = static_cast<PCB_TRACK*>( aItem );
+    for( size_t i = 0; i < tracks.size(); ++i )
+    {
+        const FINDINGS& found = findings[i];
 
-                        if( track->IsPointOnEnds( other->GetStart() )
-                                && track->IsPointOnEnds( other->GetEnd() )
-                                && track->GetWidth() == other->GetWidth()
-                                && track->GetLayer() == other->GetLayer() )
-                        {
-                            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_TRACK );
-                            item->SetItems( track );
-                            m_itemsList->push_back( item );
+        for( int ii = 0; ii < found.duplicateVias; ++ii )
+            markRedundant( tracks[i], CLEANUP_REDUNDANT_VIA );
 
-                            track->SetFlags( IS_DELETED );
-                            toRemove.insert( track );
-                        }
+        if( found.throughPad )
+            markRedundant( tracks[i], CLEANUP_REDUNDANT_VIA, found.throughPad );
 
-                        return true;
-                    } );
+        if( found.nullSegment )
+            markRedundant( tracks[i], CLEANUP_ZERO_LENGTH_TRACK );
 
-            track->SetFlags( SKIP_STRUCT );
-        }
+        for( int ii = 0; ii < found.duplicateTracks; ++ii )
+            markRedundant( tracks[i], CLEANUP_DUPLICATE_TRACK );
     }
 
     if( !m_dryRun )
@@ -413,8 +483,6 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
                 if( segment->HasFlag( IS_DELETED ) )  // already taken in account
                     continue;
 
-                auto connectivity = m_brd->GetConnectivity();
-
                 auto& entry = connectivity->GetConnectivityAlgo()->ItemEntry( segment );
 
                 for( CN_ITEM* citem : entry.GetItems() )
@@ -441,7 +509,9 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
                     }
                 }
             }
-        } while( merged );
+
+            // A dry run doesn't change the geometry, so a second pass couldn't find anything new
+        } while( merged && !m_dryRun );
     }
 
     for( PCB_TRACK* track : m_brd->Tracks() )
@@ -0,0 +1,98 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <undo_item_copies.h>
+
+#include <footprint.h>
+#include <undo_redo_container.h>
+
+
+static size_t countItemCopies( const PICKED_ITEMS_LIST* aCommand )
+{
+    size_t count = 0;
+
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ii++ )
+    {
+        EDA_ITEM* copy = nullptr;
+
+        if( aCommand->GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+            copy = aCommand->GetPickedItem( ii );
+        else
+            copy = aCommand->GetPickedItemLink( ii );
+
+        if( !copy )
+            continue;
+
+        count++;
+
+        if( copy->Type() == PCB_FOOTPRINT_T )
+        {
+            FOOTPRINT* footprint = static_cast<FOOTPRINT*>( copy );
+
+            // The reference and value texts aren't in GraphicalItems()
+            count += footprint->Pads().size() + footprint->GraphicalItems().size()
+                        + footprint->Zones().size() + 2;
+        }
+    }
+
+    return count;
+}
+
+
+void UNDO_ITEM_COPIES::Add( const PICKED_ITEMS_LIST* aCommand )
+{
+    size_t copies = countItemCopies( aCommand );
+
+    m_copies[ aCommand ] = copies;
+    m_total += copies;
+}
+
+
+void UNDO_ITEM_COPIES::Remove( const PICKED_ITEMS_LIST* aCommand )
+{
+    auto it = m_copies.find( aCommand );
+
+    if( it != m_copies.end() )
+    {
+        m_total -= it->second;
+        m_copies.erase( it );
+    }
+}
+
+
+int UNDO_ITEM_COPIES::ExcessCommands( const UNDO_REDO_CONTAINER& aList, size_t aBudget ) const
+{
+    size_t total = m_total;
+    int    extraitems = 0;
+
+    // Always keep the most recent command, whatever its size
+    while( total > aBudget && extraitems + 1 < (int) aList.m_CommandsList.size() )
+    {
+        auto it = m_copies.find( aList.m_CommandsList[ extraitems++ ] );
+
+        if( it != m_copies.end() )
+            total -= it->second;
+    }
+
+    return extraitems;
+}
@@ -0,0 +1,74 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef UNDO_ITEM_COPIES_H
+#define UNDO_ITEM_COPIES_H
+
+#include <unordered_map>
+
+class PICKED_ITEMS_LIST;
+class UNDO_REDO_CONTAINER;
+
+
+/**
+ * Keep count of the item copies held by the commands of an undo list, to bound its size.
+ *
+ * This is a count of items, not of bytes: it is cheap and good enough to bound the memory held
+ * by the undo list, whose items are all of a similar size.  A footprint copy holds copies of
+ * all its children as well.
+ */
+class UNDO_ITEM_COPIES
+{
+public:
+    UNDO_ITEM_COPIES() :
+            m_total( 0 )
+    {
+    }
+
+    /**
+     * Count the item copies held by a command added to the undo list.
+     */
+    void Add( const PICKED_ITEMS_LIST* aCommand );
+
+    /**
+     * Forget a command removed from the undo list.  Unknown commands are ignored.
+     */
+    void Remove( const PICKED_ITEMS_LIST* aCommand );
+
+    /**
+     * @return the number of oldest commands to drop from \a aList for it to hold no more than
+     *         \a aBudget item copies.  The most recent command is always kept.
+     */
+    int ExcessCommands( const UNDO_REDO_CONTAINER& aList, size_t aBudget ) const;
+
+    /**
+     * @return the number of item copies held by all the commands counted.
+     */
+    size_t GetTotal() const { return m_total; }
+
+private:
+    std::unordered_map<const PICKED_ITEMS_LIST*, size_t> m_copies;
+    size_t                                               m_total;
+};
+
+#endif // UNDO_ITEM_COPIES_H
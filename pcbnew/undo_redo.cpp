@@ -26,7 +26,9 @@
  */
 
 #include <functional>
+#include <unordered_set>
 using namespace std::placeholders;
+#include <advanced_config.h>
 #include <macros.h>
 #include <pcb_edit_frame.h>
 #include <board.h>
@@ -98,60 +100,37 @@ using namespace std::placeholders;
 
 
 /**
- * Function TestForExistingItem
- * Test if aItem exists somewhere in undo/redo lists of items.  Used by PutDataInPreviousState
- * to be sure an item was not deleted since an undo or redo.
+ * Collect the items on the board, which PutDataInPreviousState uses to be sure an item was not
+ * deleted since an undo or redo.
  * This could be possible:
  *   - if a call to SaveCopyInUndoList was forgotten in Pcbnew
  *   - in zones outlines, when a change in one zone merges this zone with an other
- * Before using this function to test existence of items, it must be called with aItem = NULL to
- * prepare the list
+ * The items are collected once per undo/redo rather than searched for each restored item, which
+ * made undoing large edits quadratic.
  * @param aPcb = board to test
- * @param aItem = item to find
- *              = NULL to build the list of existing items
+ * @param aItems = set to fill with the existing items
  */
-
-static bool TestForExistingItem( BOARD* aPcb, BOARD_ITEM* aItem )
+static void CollectExistingItems( BOARD* aPcb, std::unordered_set<const EDA_ITEM*>& aItems )
 {
     for( PCB_TRACK* item : aPcb->Tracks() )
-    {
-        if( aItem == static_cast<BOARD_ITEM*>( item ) )
-            return true;
-    }
+        aItems.insert( item );
 
     for( FOOTPRINT* item : aPcb->Footprints() )
-    {
-        if( aItem == static_cast<BOARD_ITEM*>( item ) )
-            return true;
-    }
+        aItems.insert( item );
 
     for( BOARD_ITEM* item : aPcb->Drawings() )
-    {
-        if( aItem == static_cast<BOARD_ITEM*>( item ) )
-            return true;
-    }
+        aItems.insert( item );
 
     for( ZONE* item : aPcb->Zones() )
-    {
-        if( aItem == static_cast<BOARD_ITEM*>( item ) )
-            return true;
-    }
+        aItems.insert( item );
 
     NETINFO_LIST& netInfo = aPcb->GetNetInfo();
 
     for( NETINFO_LIST::iterator i = netInfo.begin(); i != netInfo.end(); ++i )
-    {
-        if( aItem == static_cast<BOARD_ITEM*>( *i ) )
-            return true;
-    }
+        aItems.insert( *i );
 
     for( PCB_GROUP* item : aPcb->Groups() )
-    {
-        if( aItem == static_cast<BOARD_ITEM*>( item ) )
-            return true;
-    }
-
-    return false;
+        aItems.insert( item );
 }
 
 
@@ -386,6 +365,9 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
 
     PCB_GROUP* group = nullptr;
 
+    std::unordered_set<const EDA_ITEM*> existingItems;
+    CollectExistingItems( GetBoard(), existingItems );
+
     // Undo in the reverse order of list creation: (this can allow stacked changes
     // like the same item can be changes and deleted in the same complex command
 
@@ -408,7 +390,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
                 && status != UNDO_REDO::GRIDORIGIN      // origin markers never on board
                 && status != UNDO_REDO::PAGESETTINGS )  // nor are page settings proxy items
         {
-            if( !TestForExistingItem( GetBoard(), (BOARD_ITEM*) eda_item ) )
+            if( !existingItems.count( eda_item ) )
             {
                 // Checking if it ever happens
                 wxASSERT_MSG( false, "Item in the undo buffer does not exist" );
@@ -474,6 +456,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
         case UNDO_REDO::NEWITEM:        /* new items are deleted */
             aList->SetPickedItemStatus( UNDO_REDO::DELETED, ii );
             GetModel()->Remove( (BOARD_ITEM*) eda_item );
+            existingItems.erase( eda_item );
 
             if( eda_item->Type() != PCB_NETINFO_T )
                 view->Remove( eda_item );
@@ -483,6 +466,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
         case UNDO_REDO::DELETED:    /* deleted items are put in List, as new items */
             aList->SetPickedItemStatus( UNDO_REDO::NEWITEM, ii );
             GetModel()->Add( (BOARD_ITEM*) eda_item );
+            existingItems.insert( eda_item );
 
             if( eda_item->Type() != PCB_NETINFO_T )
                 view->Add( eda_item );
@@ -554,6 +538,36 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
 }
 
 
+void PCB_BASE_EDIT_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
+{
+    m_undoItemCopies.Add( aItem );
+
+    PCB_BASE_FRAME::PushCommandToUndoList( aItem );
+
+    /* Drop the oldest commands if the undo list holds too many item copies */
+    int budget = ADVANCED_CFG::GetCfg().m_UndoItemBudget;
+
+    if( budget > 0 && m_undoItemCopies.GetTotal() > (size_t) budget )
+    {
+        int extraitems = m_undoItemCopies.ExcessCommands( m_undoList, budget );
+
+        if( extraitems > 0 )
+            ClearUndoORRedoList( UNDO_LIST, extraitems );
+    }
+}
+
+
+PICKED_ITEMS_LIST* PCB_BASE_EDIT_FRAME::PopCommandFromUndoList()
+{
+    PICKED_ITEMS_LIST* command = PCB_BASE_FRAME::PopCommandFromUndoList();
+
+    if( command )
+        m_undoItemCopies.Remove( command );
+
+    return command;
+}
+
+
 void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aItemCount )
 {
     if( aItemCount == 0 )
@@ -573,6 +587,9 @@ void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aIt
         PICKED_ITEMS_LIST* curr_cmd = list.m_CommandsList[0];
         list.m_CommandsList.erase( list.m_CommandsList.begin() );
 
+        if( whichList == UNDO_LIST )
+            m_undoItemCopies.Remove( curr_cmd );
+
         curr_cmd->ClearListAndDeleteItems();
         delete curr_cmd;    // Delete command
     }
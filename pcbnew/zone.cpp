@@ -313,6 +313,15 @@ double ZONE::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
 }
 
 
+void ZONE::ViewPrepareDraw()
+{
+    // The zone filler may be storing new fills from its own threads
+    std::unique_lock<std::mutex> lock( m_lock );
+
+    CacheTriangulation();
+}
+
+
 bool ZONE::IsOnLayer( PCB_LAYER_ID aLayer ) const
 {
     return m_layerSet.test( aLayer );
@@ -1109,17 +1118,17 @@ void ZONE::SwapData( BOARD_ITEM* aImage )
 }
 
 
-void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
+void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer, bool aAllowThreads )
 {
     if( aLayer == UNDEFINED_LAYER )
     {
         for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
-            pair.second.CacheTriangulation();
+            pair.second.CacheTriangulation( true, aAllowThreads );
     }
     else
     {
         if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ].CacheTriangulation();
+            m_FilledPolysList[ aLayer ].CacheTriangulation( true, aAllowThreads );
     }
 }
 
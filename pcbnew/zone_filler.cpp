@@ -412,7 +412,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
             {
                 MD5_HASH was = zone->GetHashValue( layer );
-                zone->CacheTriangulation( layer );
+                zone->CacheTriangulation( layer, true );
                 zone->BuildHashValue( layer );
                 MD5_HASH is = zone->GetHashValue( layer );
 
@@ -449,7 +449,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
                 for( size_t i = nextItem++; i < islandsList.size(); i = nextItem++ )
                 {
-                    islandsList[i].m_zone->CacheTriangulation();
+                    islandsList[i].m_zone->CacheTriangulation( UNDEFINED_LAYER, true );
                     num++;
 
                     if( m_progressReporter )
@@ -464,33 +464,26 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                 return num;
             };
 
-    size_t parallelThreadCount = std::min( cores, islandsList.size() );
-    std::vector<std::future<size_t>> returns( parallelThreadCount );
-
-    if( parallelThreadCount <= 1 )
-        tri_lambda( m_progressReporter );
-    else
+    // A single worker walks the zones and triangulates the polygons of each one in parallel,
+    // while this thread keeps the progress reporter refreshed
+    if( !islandsList.empty() )
     {
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii] = std::async( std::launch::async, tri_lambda, m_progressReporter );
+        std::future<size_t> ret = std::async( std::launch::async, tri_lambda, m_progressReporter );
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        // Here we balance returns with a 100ms timeout to allow UI updating
+        std::future_status status;
+        do
         {
-            // Here we balance returns with a 100ms timeout to allow UI updating
-            std::future_status status;
-            do
+            if( m_progressReporter )
             {
-                if( m_progressReporter )
-                {
-                    m_progressReporter->KeepRefreshing();
+                m_progressReporter->KeepRefreshing();
 
-                    if( m_progressReporter->IsCancelled() )
-                        break;
-                }
+                if( m_progressReporter->IsCancelled() )
+                    break;
+            }
 
-                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
-            } while( status != std::future_status::ready );
-        }
+            status = ret.wait_for( std::chrono::milliseconds( 100 ) );
+        } while( status != std::future_status::ready );
     }
 
     if( m_progressReporter )
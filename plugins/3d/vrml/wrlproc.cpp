@@ -21,6 +21,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <wx/filename.h>
@@ -46,6 +51,69 @@
     } } while( 0 )
 
 
+/**
+ * Convert a glob to a float.  The whole glob must be a finite decimal number.
+ *
+ * This is called for every value of the coordinate and index arrays so it avoids creating
+ * a stream for each value.  The numeric locale is set to "C" while models are loaded.
+ */
+static bool parseFloat( const std::string& aGlob, float& aResult )
+{
+    // strtof() also accepts "inf", "nan" and hexadecimal floats, which aren't VRML numbers
+    if( aGlob.empty() || aGlob.find_first_not_of( "0123456789+-.eE" ) != std::string::npos )
+        return false;
+
+    const char* start = aGlob.c_str();
+    char*       end = nullptr;
+
+    errno = 0;
+    aResult = strtof( start, &end );
+
+    // An underflow gives a usable value close to 0; an overflow doesn't
+    if( errno == ERANGE && std::isinf( aResult ) )
+        return false;
+
+    return end == start + aGlob.size();
+}
+
+
+/**
+ * Convert a glob to an SFInt32.  The whole glob must be a number which fits in 32 bits.
+ *
+ * Hexadecimal values are bit patterns (for instance the pixels of an SFImage), so they may go
+ * up to 0xFFFFFFFF.
+ */
+static bool parseInt( const std::string& aGlob, int& aResult, int aBase = 10 )
+{
+    if( aGlob.empty() )
+        return false;
+
+    const char* start = aGlob.c_str();
+    char*       end = nullptr;
+
+    errno = 0;
+    long long value = strtoll( start, &end, aBase );
+
+    if( errno == ERANGE || end != start + aGlob.size() )
+        return false;
+
+    if( aBase == 16 )
+    {
+        if( value < INT_MIN || value > (long long) UINT32_MAX )
+            return false;
+
+        aResult = (int) (int32_t) (uint32_t) value;
+        return true;
+    }
+
+    if( value < INT_MIN || value > INT_MAX )
+        return false;
+
+    aResult = (int) value;
+    return true;
+}
+
+
 WRLPROC::WRLPROC( LINE_READER* aLineReader )
 {
     m_fileVersion = WRLVERSION::VRML_INVALID;
@@ -256,23 +324,26 @@ bool WRLPROC::ReadGlob( std::string& aGlob )
     }
 
     size_t ssize = m_buf.size();
+    size_t start = m_bufpos;
 
     while( m_bufpos < ssize && m_buf[m_bufpos] > 0x20 )
     {
         if( ',' == m_buf[m_bufpos] )
         {
             // the comma is a special instance of blank space
+            aGlob.assign( m_buf, start, m_bufpos - start );
             ++m_bufpos;
             return true;
         }
 
         if( '{' == m_buf[m_bufpos] || '}' == m_buf[m_bufpos]
             || '[' == m_buf[m_bufpos] || ']' == m_buf[m_bufpos] )
-            return true;
+            break;
 
-        aGlob.append( 1, m_buf[m_bufpos++] );
+        ++m_bufpos;
     }
 
+    aGlob.assign( m_buf, start, m_bufpos - start );
     return true;
 }
 
@@ -826,11 +897,7 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
         return false;
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-    istr >> aSFFloat;
-
-    if( istr.fail() || !istr.eof() )
+    if( !parseFloat( tmp, aSFFloat ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -886,28 +953,27 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
         return false;
     }
 
+    bool parsed;
+
     if( std::string::npos != tmp.find( "0x" ) )
     {
         // Rules: "0x" + "0-9, A-F" - VRML is case sensitive but in
         // this instance we do no enforce case.
-        std::stringstream sstr;
-        sstr << std::hex << tmp;
-        sstr >> aSFInt32;
-        return true;
+        parsed = parseInt( tmp, aSFInt32, 16 );
+    }
+    else
+    {
+        parsed = parseInt( tmp, aSFInt32 );
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-    istr >> aSFInt32;
-
-    if( istr.fail() || !istr.eof() )
+    if( !parsed )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
         ostr << " * [INFO] failed on file '" << m_filename << "'\n";
         ostr << " * [INFO] line " << fileline << ", char " << linepos << " -- ";
         ostr << "line " << m_fileline << ", char " << m_bufpos << "\n";
-        ostr << " * [INFO] invalid character in SFInt";
+        ostr << " * [INFO] invalid character or out of range value in SFInt";
         m_error = ostr.str();
 
         return false;
@@ -963,11 +1029,7 @@ bool WRLPROC::ReadSFRotation( WRLROTATION& aSFRotation )
             return false;
         }
 
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> trot[i];
-
-        if( istr.fail() || !istr.eof() )
+        if( !parseFloat( tmp, trot[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1036,11 +1098,7 @@ bool WRLPROC::ReadSFVec2f( WRLVEC2F& aSFVec2f )
             return false;
         }
 
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> tcol[i];
-
-        if( istr.fail() || !istr.eof() )
+        if( !parseFloat( tmp, tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1115,11 +1173,7 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
         if( ',' == m_buf[m_bufpos] )
             Pop();
 
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> tcol[i];
-
-        if( istr.fail() || !istr.eof() )
+        if( !parseFloat( tmp, tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -0,0 +1,305 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <gal/gal_display_options.h>
+#include <gal/graphics_abstraction_layer.h>
+#include <painter.h>
+#include <view/view.h>
+#include <view/view_item.h>
+
+#include <map>
+#include <set>
+
+
+// All these tests are of a class in KIGFX
+using namespace KIGFX;
+
+
+namespace
+{
+
+const int LOD_LAYER = 1;
+const int TILE_SIZE = 1000;
+
+
+/**
+ * A GAL which only keeps track of the groups.
+ */
+class LOD_TEST_GAL : public GAL
+{
+public:
+    LOD_TEST_GAL( GAL_DISPLAY_OPTIONS& aOptions ) :
+            GAL( aOptions ),
+            m_nextGroup( 1 ),
+            m_currentGroup( -1 )
+    {
+    }
+
+    int BeginGroup() override
+    {
+        m_currentGroup = m_nextGroup++;
+        return m_currentGroup;
+    }
+
+    void EndGroup() override { m_currentGroup = -1; }
+
+    void DeleteGroup( int aGroupNumber ) override { m_deletedGroups.insert( aGroupNumber ); }
+
+    int           m_nextGroup;
+    int           m_currentGroup;
+    std::set<int> m_deletedGroups;
+};
+
+
+/**
+ * A painter recording which items are drawn in each aggregated drawing group.
+ */
+class LOD_TEST_PAINTER : public PAINTER
+{
+public:
+    LOD_TEST_PAINTER( LOD_TEST_GAL* aGal ) :
+            PAINTER( aGal ),
+            m_testGal( aGal )
+    {
+    }
+
+    RENDER_SETTINGS* GetSettings() override { return nullptr; }
+
+    bool Draw( const VIEW_ITEM* aItem, int aLayer ) override { return true; }
+
+    bool DrawLOD( const VIEW_ITEM* aItem, int aLayer ) override
+    {
+        m_lodGroups[ m_testGal->m_currentGroup ].insert( aItem );
+        return true;
+    }
+
+    LOD_TEST_GAL*                             m_testGal;
+    std::map<int, std::set<const VIEW_ITEM*>> m_lodGroups;
+};
+
+
+class LOD_TEST_ITEM : public VIEW_ITEM
+{
+public:
+    LOD_TEST_ITEM( const VECTOR2I& aCenter ) { SetCenter( aCenter ); }
+
+    void SetCenter( const VECTOR2I& aCenter )
+    {
+        m_bbox = BOX2I( aCenter - VECTOR2I( 50, 50 ), VECTOR2I( 100, 100 ) );
+    }
+
+    const BOX2I ViewBBox() const override { return m_bbox; }
+
+    void ViewGetLayers( int aLayers[], int& aCount ) const override
+    {
+        aLayers[0] = LOD_LAYER;
+        aCount = 1;
+    }
+
+    BOX2I m_bbox;
+};
+
+} // namespace
+
+
+class VIEW_LOD_FIXTURE
+{
+public:
+    VIEW_LOD_FIXTURE() :
+            m_gal( m_options ),
+            m_painter( &m_gal ),
+            m_itemA( { 500, 500 } ),      // Tile (0, 0)
+            m_itemB( { 1500, 500 } ),     // Tile (1, 0)
+            m_itemC( { -500, 500 } ),     // Tile (-1, 0)
+            m_itemD( { 600, 400 } )       // Tile (0, 0)
+    {
+        m_view.SetGAL( &m_gal );
+        m_view.SetPainter( &m_painter );
+        m_view.SetLayerAggregated( LOD_LAYER );
+        m_view.SetLODThreshold( 1.0, TILE_SIZE );
+        m_view.SetScale( 0.5 );
+
+        for( LOD_TEST_ITEM* item : { &m_itemA, &m_itemB, &m_itemC, &m_itemD } )
+            m_view.Add( item );
+
+        m_view.UpdateItems();
+    }
+
+    /// Forget the groups built so far, to check what the next update rebuilds
+    void resetRecords()
+    {
+        m_painter.m_lodGroups.clear();
+        m_gal.m_deletedGroups.clear();
+    }
+
+    /// @return the aggregated drawing group holding \a aItem, or -1.
+    int groupOf( const VIEW_ITEM* aItem ) const
+    {
+        for( const auto& group : m_painter.m_lodGroups )
+        {
+            if( group.second.count( aItem ) )
+                return group.first;
+        }
+
+        return -1;
+    }
+
+    GAL_DISPLAY_OPTIONS m_options;
+    LOD_TEST_GAL        m_gal;
+    LOD_TEST_PAINTER    m_painter;
+    VIEW                m_view;
+
+    // Declared after the view, so that they leave it before it is destroyed
+    LOD_TEST_ITEM       m_itemA;
+    LOD_TEST_ITEM       m_itemB;
+    LOD_TEST_ITEM       m_itemC;
+    LOD_TEST_ITEM       m_itemD;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ViewLOD, VIEW_LOD_FIXTURE )
+
+
+/**
+ * Items are drawn in the group of the tile containing the center of their bounding box.
+ */
+BOOST_AUTO_TEST_CASE( TileAssignment )
+{
+    BOOST_CHECK_EQUAL( m_painter.m_lodGroups.size(), 3 );
+
+    int groupA = groupOf( &m_itemA );
+
+    BOOST_CHECK_NE( groupA, -1 );
+    BOOST_CHECK_EQUAL( groupOf( &m_itemD ), groupA );
+    BOOST_CHECK_NE( groupOf( &m_itemB ), groupA );
+    BOOST_CHECK_NE( groupOf( &m_itemC ), groupA );
+    BOOST_CHECK_NE( groupOf( &m_itemB ), groupOf( &m_itemC ) );
+}
+
+
+/**
+ * Updating an item only rebuilds its own tile, or both tiles when it moves to another one.
+ */
+BOOST_AUTO_TEST_CASE( UpdateMarksTileDirty )
+{
+    int groupA = groupOf( &m_itemA );
+    int groupB = groupOf( &m_itemB );
+    int groupC = groupOf( &m_itemC );
+
+    resetRecords();
+
+    // Within its tile
+    m_itemB.SetCenter( { 1600, 600 } );
+    m_view.Update( &m_itemB, GEOMETRY );
+    m_view.UpdateItems();
+
+    BOOST_CHECK_EQUAL( m_painter.m_lodGroups.size(), 1 );
+    BOOST_CHECK_NE( groupOf( &m_itemB ), -1 );
+    BOOST_CHECK( m_gal.m_deletedGroups.count( groupB ) );
+    BOOST_CHECK( !m_gal.m_deletedGroups.count( groupA ) );
+    BOOST_CHECK( !m_gal.m_deletedGroups.count( groupC ) );
+
+    groupB = groupOf( &m_itemB );
+    resetRecords();
+
+    // To the tile of A and D: the tile it leaves is left empty
+    m_itemB.SetCenter( { 700, 700 } );
+    m_view.Update( &m_itemB, GEOMETRY );
+    m_view.UpdateItems();
+
+    BOOST_CHECK_EQUAL( m_painter.m_lodGroups.size(), 1 );
+    BOOST_CHECK_NE( groupOf( &m_itemA ), -1 );
+    BOOST_CHECK_EQUAL( groupOf( &m_itemB ), groupOf( &m_itemA ) );
+    BOOST_CHECK_EQUAL( groupOf( &m_itemD ), groupOf( &m_itemA ) );
+    BOOST_CHECK( m_gal.m_deletedGroups.count( groupA ) );
+    BOOST_CHECK( m_gal.m_deletedGroups.count( groupB ) );
+    BOOST_CHECK( !m_gal.m_deletedGroups.count( groupC ) );
+}
+
+
+/**
+ * Removing an item rebuilds its tile without it.
+ */
+BOOST_AUTO_TEST_CASE( RemoveMarksTileDirty )
+{
+    int groupA = groupOf( &m_itemA );
+    int groupB = groupOf( &m_itemB );
+
+    resetRecords();
+
+    m_view.Remove( &m_itemA );
+    m_view.UpdateItems();
+
+    BOOST_CHECK_EQUAL( m_painter.m_lodGroups.size(), 1 );
+    BOOST_CHECK_EQUAL( groupOf( &m_itemA ), -1 );
+    BOOST_CHECK_NE( groupOf( &m_itemD ), -1 );
+    BOOST_CHECK( m_gal.m_deletedGroups.count( groupA ) );
+    BOOST_CHECK( !m_gal.m_deletedGroups.count( groupB ) );
+}
+
+
+/**
+ * Changing the tile size or the layer visibility discards every tile.
+ */
+BOOST_AUTO_TEST_CASE( CacheInvalidation )
+{
+    std::set<int> oldGroups;
+
+    for( const auto& group : m_painter.m_lodGroups )
+        oldGroups.insert( group.first );
+
+    resetRecords();
+
+    // Items A, B and D now share tile (0, 0)
+    m_view.SetLODThreshold( 1.0, 2 * TILE_SIZE );
+    m_view.UpdateItems();
+
+    for( int group : oldGroups )
+        BOOST_CHECK( m_gal.m_deletedGroups.count( group ) );
+
+    BOOST_CHECK_EQUAL( m_painter.m_lodGroups.size(), 2 );
+    BOOST_CHECK_EQUAL( groupOf( &m_itemB ), groupOf( &m_itemA ) );
+    BOOST_CHECK_EQUAL( groupOf( &m_itemD ), groupOf( &m_itemA ) );
+    BOOST_CHECK_NE( groupOf( &m_itemC ), groupOf( &m_itemA ) );
+
+    oldGroups.clear();
+
+    for( const auto& group : m_painter.m_lodGroups )
+        oldGroups.insert( group.first );
+
+    resetRecords();
+
+    // The visibility of an item can depend on other layers, so all tiles are rebuilt
+    m_view.SetLayerVisible( LOD_LAYER + 1, false );
+    m_view.UpdateItems();
+
+    for( int group : oldGroups )
+        BOOST_CHECK( m_gal.m_deletedGroups.count( group ) );
+
+    BOOST_CHECK_EQUAL( m_painter.m_lodGroups.size(), 2 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
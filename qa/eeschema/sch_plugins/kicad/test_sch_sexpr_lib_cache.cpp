@@ -0,0 +1,225 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the symbol library cache of the KiCad s-expression schematic plugin.
+ */
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <lib_symbol.h>
+#include <locale_io.h>
+#include <properties.h>
+#include <richio.h>
+#include <sch_plugins/kicad/sch_sexpr_parser.h>
+#include <symbol_lib_table.h>
+#include <symbol_library.h>
+
+// Code under test
+#include <sch_plugins/kicad/sch_sexpr_plugin.h>
+
+
+// The alias is stored before its parent, and the description contains parentheses and escaped
+// quotes which must not confuse the index.
+static const char* s_aliasFirstLib =
+        "(kicad_symbol_lib (version 20201005) (generator kicad_symbol_editor)\n"
+        "  (symbol \"R_Alt\" (extends \"R\")\n"
+        "    (property \"Value\" \"R_Alt\" (id 1) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27))))\n"
+        "  )\n"
+        "  (symbol \"R\" (in_bom yes) (on_board yes)\n"
+        "    (property \"Reference\" \"R\" (id 0) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27))))\n"
+        "    (property \"ki_description\" \"Resistor (generic) \\\"R\\\" )(\" (id 4)\n"
+        "      (at 0 0 0) (effects (font (size 1.27 1.27)) hide))\n"
+        "  )\n"
+        "  (symbol \"GND\" (power) (in_bom yes) (on_board yes)\n"
+        "    (property \"Reference\" \"#PWR\" (id 0) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27)) hide))\n"
+        "  )\n"
+        "  (symbol \"GND_Alt\" (extends \"GND\")\n"
+        "    (property \"Value\" \"GND_Alt\" (id 1) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27))))\n"
+        "  )\n"
+        ")\n";
+
+
+// The same symbols with every parent before its aliases, as the whole-file parser needs them.
+static const char* s_parentFirstLib =
+        "(kicad_symbol_lib (version 20201005) (generator kicad_symbol_editor)\n"
+        "  (symbol \"R\" (in_bom yes) (on_board yes)\n"
+        "    (property \"Reference\" \"R\" (id 0) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27))))\n"
+        "    (property \"ki_description\" \"Resistor (generic) \\\"R\\\" )(\" (id 4)\n"
+        "      (at 0 0 0) (effects (font (size 1.27 1.27)) hide))\n"
+        "  )\n"
+        "  (symbol \"R_Alt\" (extends \"R\")\n"
+        "    (property \"Value\" \"R_Alt\" (id 1) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27))))\n"
+        "  )\n"
+        "  (symbol \"GND\" (power) (in_bom yes) (on_board yes)\n"
+        "    (property \"Reference\" \"#PWR\" (id 0) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27)) hide))\n"
+        "  )\n"
+        "  (symbol \"GND_Alt\" (extends \"GND\")\n"
+        "    (property \"Value\" \"GND_Alt\" (id 1) (at 0 0 0)\n"
+        "      (effects (font (size 1.27 1.27))))\n"
+        "  )\n"
+        ")\n";
+
+
+class SEXPR_LIB_CACHE_FIXTURE
+{
+public:
+    SEXPR_LIB_CACHE_FIXTURE()
+    {
+        m_libPath = boost::filesystem::temp_directory_path()
+                    / boost::filesystem::unique_path( "qa_sexpr_lib_%%%%-%%%%.kicad_sym" );
+
+        writeLib( s_aliasFirstLib );
+    }
+
+    ~SEXPR_LIB_CACHE_FIXTURE()
+    {
+        boost::filesystem::remove( m_libPath );
+    }
+
+    void writeLib( const char* aContents )
+    {
+        std::ofstream out( m_libPath.string(), std::ios::trunc );
+        out << aContents;
+    }
+
+    wxString libPath() const { return wxString( m_libPath.string() ); }
+
+    boost::filesystem::path m_libPath;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchSexprLibCache, SEXPR_LIB_CACHE_FIXTURE )
+
+
+/**
+ * Symbol names and power symbols are enumerated from the index.
+ */
+BOOST_AUTO_TEST_CASE( EnumerateNames )
+{
+    SCH_SEXPR_PLUGIN plugin;
+    wxArrayString    names;
+
+    plugin.EnumerateSymbolLib( names, libPath() );
+
+    BOOST_REQUIRE_EQUAL( names.size(), 4 );
+    BOOST_CHECK_EQUAL( names[0], "GND" );
+    BOOST_CHECK_EQUAL( names[1], "GND_Alt" );
+    BOOST_CHECK_EQUAL( names[2], "R" );
+    BOOST_CHECK_EQUAL( names[3], "R_Alt" );
+
+    PROPERTIES powerOnly;
+    powerOnly.emplace( SYMBOL_LIB_TABLE::PropPowerSymsOnly, "" );
+
+    wxArrayString powerNames;
+    plugin.EnumerateSymbolLib( powerNames, libPath(), &powerOnly );
+
+    BOOST_REQUIRE_EQUAL( powerNames.size(), 2 );
+    BOOST_CHECK_EQUAL( powerNames[0], "GND" );
+    BOOST_CHECK_EQUAL( powerNames[1], "GND_Alt" );
+
+    std::vector<LIB_SYMBOL*> powerSymbols;
+    plugin.EnumerateSymbolLib( powerSymbols, libPath(), &powerOnly );
+
+    BOOST_REQUIRE_EQUAL( powerSymbols.size(), 2 );
+
+    for( LIB_SYMBOL* symbol : powerSymbols )
+        BOOST_CHECK( symbol->IsPower() );
+}
+
+
+/**
+ * Loading an alias first loads the symbol it extends.
+ */
+BOOST_AUTO_TEST_CASE( LoadAlias )
+{
+    SCH_SEXPR_PLUGIN plugin;
+    LIB_SYMBOL*      alias = plugin.LoadSymbol( libPath(), "R_Alt" );
+
+    BOOST_REQUIRE( alias );
+    BOOST_CHECK( alias->IsAlias() );
+    BOOST_CHECK_EQUAL( alias->GetDescription(), "Resistor (generic) \"R\" )(" );
+
+    std::shared_ptr<LIB_SYMBOL> parent = alias->GetParent().lock();
+
+    BOOST_REQUIRE( parent );
+    BOOST_CHECK( parent.get() == plugin.LoadSymbol( libPath(), "R" ) );
+
+    BOOST_CHECK( plugin.LoadSymbol( libPath(), "Missing" ) == nullptr );
+}
+
+
+/**
+ * Symbols loaded on demand are the same as the ones the parser builds from the whole file.
+ */
+BOOST_AUTO_TEST_CASE( MatchesFullLoad )
+{
+    writeLib( s_parentFirstLib );
+
+    LIB_SYMBOL_MAP fullSymbols;
+
+    {
+        LOCALE_IO        toggle;
+        FILE_LINE_READER reader( libPath() );
+        SCH_SEXPR_PARSER parser( &reader );
+
+        parser.ParseLib( fullSymbols );
+    }
+
+    BOOST_REQUIRE_EQUAL( fullSymbols.size(), 4 );
+
+    SCH_SEXPR_PLUGIN lazyPlugin;
+
+    for( const std::pair<const wxString, LIB_SYMBOL*>& entry : fullSymbols )
+    {
+        LIB_SYMBOL* symbol = entry.second;
+
+        BOOST_TEST_CONTEXT( symbol->GetName() )
+        {
+            LIB_SYMBOL* lazySymbol = lazyPlugin.LoadSymbol( libPath(), symbol->GetName() );
+
+            BOOST_REQUIRE( lazySymbol );
+            BOOST_CHECK( *lazySymbol == *symbol );
+            BOOST_CHECK_EQUAL( lazySymbol->IsPower(), symbol->IsPower() );
+            BOOST_CHECK_EQUAL( lazySymbol->IsAlias(), symbol->IsAlias() );
+            BOOST_CHECK_EQUAL( lazySymbol->GetDescription(), symbol->GetDescription() );
+        }
+    }
+
+    for( const std::pair<const wxString, LIB_SYMBOL*>& entry : fullSymbols )
+        delete entry.second;
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
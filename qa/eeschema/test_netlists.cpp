@@ -21,11 +21,14 @@
 #include "eeschema_test_utils.h"
 
 #include <connection_graph.h>
+#include <convert_to_biu.h>
 #include <netlist_exporter_kicad.h>
 #include <netlist_reader/netlist_reader.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <project.h>
 #include <sch_io_mgr.h>
+#include <sch_line.h>
+#include <sch_screen.h>
 #include <sch_sheet.h>
 #include <schematic.h>
 #include <settings/settings_manager.h>
@@ -52,14 +55,21 @@ public:
 
     wxString getNetlistFileName( bool aTest = false );
 
-    void writeNetlist();
+    void writeNetlist( const wxString& aFileName );
 
-    void compareNetlists();
+    void writeNetlist() { writeNetlist( getNetlistFileName( true ) ); }
+
+    void compareNetlists( const wxString& aGoldenFile, const wxString& aTestFile );
+
+    void compareNetlists() { compareNetlists( getNetlistFileName(), getNetlistFileName( true ) ); }
 
     void cleanup();
 
     void doNetlistTest( const wxString& aBaseName );
 
+    void doIncrementalNetlistTest( const wxString& aBaseName,
+                                   const std::function<void( SCH_SCREEN*, SCH_LINE* )>& aEdit );
+
     ///> Schematic to load
     SCHEMATIC m_schematic;
 
@@ -139,28 +149,29 @@ wxString TEST_NETLISTS_FIXTURE::getNetlistFileName( bool aTest )
 }
 
 
-void TEST_NETLISTS_FIXTURE::writeNetlist()
+void TEST_NETLISTS_FIXTURE::writeNetlist( const wxString& aFileName )
 {
     auto exporter = std::make_unique<NETLIST_EXPORTER_KICAD>( &m_schematic );
-    BOOST_REQUIRE_EQUAL( exporter->WriteNetlist( getNetlistFileName( true ), 0 ), true );
+    BOOST_REQUIRE_EQUAL( exporter->WriteNetlist( aFileName, 0 ), true );
 }
 
 
-void TEST_NETLISTS_FIXTURE::compareNetlists()
+void TEST_NETLISTS_FIXTURE::compareNetlists( const wxString& aGoldenFile,
+                                             const wxString& aTestFile )
 {
     NETLIST golden;
     NETLIST test;
 
     {
         std::unique_ptr<NETLIST_READER> netlistReader( NETLIST_READER::GetNetlistReader(
-                                            &golden, getNetlistFileName(), wxEmptyString ) );
+                                            &golden, aGoldenFile, wxEmptyString ) );
 
         BOOST_REQUIRE_NO_THROW( netlistReader->LoadNetlist() );
     }
 
     {
         std::unique_ptr<NETLIST_READER> netlistReader( NETLIST_READER::GetNetlistReader(
-                                            &test, getNetlistFileName( true ), wxEmptyString ) );
+                                            &test, aTestFile, wxEmptyString ) );
 
         BOOST_REQUIRE_NO_THROW( netlistReader->LoadNetlist() );
     }
@@ -221,6 +232,56 @@ void TEST_NETLISTS_FIXTURE::doNetlistTest( const wxString& aBaseName )
 }
 
 
+/**
+ * Apply \a aEdit to a wire of the last sheet the way the editor tools do, without flagging
+ * anything for the connection graph, and check that the netlist written after an incremental
+ * recalculation is the same as after an unconditional one.
+ */
+void TEST_NETLISTS_FIXTURE::doIncrementalNetlistTest(
+        const wxString& aBaseName, const std::function<void( SCH_SCREEN*, SCH_LINE* )>& aEdit )
+{
+    loadSchematic( aBaseName );
+
+    SCH_SHEET_LIST    sheets = m_schematic.GetSheets();
+    CONNECTION_GRAPH* graph = m_schematic.ConnectionGraph();
+
+    // Nothing changed: the incremental update must match the golden netlist
+    graph->Recalculate( sheets, false );
+
+    writeNetlist();
+    compareNetlists();
+
+    SCH_SCREEN* screen = sheets.back().LastScreen();
+    SCH_LINE*   wire = nullptr;
+
+    for( SCH_ITEM* item : screen->Items().OfType( SCH_LINE_T ) )
+    {
+        if( static_cast<SCH_LINE*>( item )->IsWire() )
+        {
+            wire = static_cast<SCH_LINE*>( item );
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( wire );
+
+    aEdit( screen, wire );
+
+    graph->Recalculate( sheets, false );
+
+    wxString incrementalFile = getNetlistFileName( true ) + wxT( ".incremental" );
+    writeNetlist( incrementalFile );
+
+    graph->Recalculate( sheets, true );
+    writeNetlist();
+
+    compareNetlists( getNetlistFileName( true ), incrementalFile );
+
+    wxRemoveFile( incrementalFile );
+    cleanup();
+}
+
+
 BOOST_FIXTURE_TEST_SUITE( Netlists, TEST_NETLISTS_FIXTURE )
 
 
@@ -296,4 +357,43 @@ BOOST_AUTO_TEST_CASE( TopLevelHierPins )
 }
 
 
+BOOST_AUTO_TEST_CASE( IncrementalMoveWire )
+{
+    // As SCH_MOVE_TOOL does for a selected wire
+    doIncrementalNetlistTest( "complex_hierarchy",
+            []( SCH_SCREEN* aScreen, SCH_LINE* aWire )
+            {
+                aWire->Move( wxPoint( Mils2iu( 50 ), Mils2iu( 50 ) ) );
+                aScreen->Update( aWire );
+            } );
+}
+
+
+BOOST_AUTO_TEST_CASE( IncrementalDragWire )
+{
+    // As SCH_MOVE_TOOL does for the dragged end of a wire
+    doIncrementalNetlistTest( "bus_junctions",
+            []( SCH_SCREEN* aScreen, SCH_LINE* aWire )
+            {
+                aWire->MoveStart( wxPoint( Mils2iu( 50 ), 0 ) );
+                aScreen->Update( aWire );
+            } );
+}
+
+
+BOOST_AUTO_TEST_CASE( IncrementalDeleteWire )
+{
+    // As SCH_BASE_FRAME::RemoveFromScreen() does.  The wire is kept alive until the end of
+    // the test so that a stale link does not point to freed memory.
+    std::unique_ptr<SCH_LINE> deletedWire;
+
+    doIncrementalNetlistTest( "complex_hierarchy",
+            [&]( SCH_SCREEN* aScreen, SCH_LINE* aWire )
+            {
+                aScreen->Remove( aWire );
+                deletedWire.reset( aWire );
+            } );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
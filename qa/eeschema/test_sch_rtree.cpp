@@ -38,6 +38,8 @@
 
 #include <qa_utils/wx_utils/wx_assert.h>
 
+#include <set>
+
 class TEST_SCH_RTREE_FIXTURE
 {
 public:
@@ -280,4 +282,73 @@ BOOST_AUTO_TEST_CASE( SingleElementTree )
         delete item;
 }
 
+// A bulk loaded tree must find the same items as a tree filled one item at a time, and must
+// keep working with incremental edits
+BOOST_AUTO_TEST_CASE( BulkLoad )
+{
+    EE_RTREE                reference;
+    std::vector<SCH_ITEM*>  items;
+
+    m_tree.BeginBulkLoad();
+
+    for( int i = 0; i < 2000; i++ )
+    {
+        wxPoint pos( Mils2iu( 50 ) * ( ( i * 37 ) % 211 ), Mils2iu( 50 ) * ( ( i * 53 ) % 199 ) );
+
+        if( i % 3 == 0 )
+            items.push_back( new SCH_NO_CONNECT( pos ) );
+        else
+            items.push_back( new SCH_JUNCTION( pos ) );
+
+        m_tree.insert( items.back() );
+        reference.insert( items.back() );
+    }
+
+    m_tree.EndBulkLoad();
+
+    BOOST_CHECK_EQUAL( m_tree.size(), items.size() );
+
+    auto checkSameResults =
+            [&]()
+            {
+                for( int i = 0; i < 50; i++ )
+                {
+                    EDA_RECT bbox( wxPoint( Mils2iu( 211 ) * i, Mils2iu( 199 ) * ( 50 - i ) ),
+                                   wxSize( Mils2iu( 40 ) * i, Mils2iu( 500 ) ) );
+
+                    for( KICAD_T type : { SCH_JUNCTION_T, SCH_NO_CONNECT_T } )
+                    {
+                        std::set<SCH_ITEM*> found;
+                        std::set<SCH_ITEM*> expected;
+
+                        for( SCH_ITEM* item : m_tree.Overlapping( type, bbox ) )
+                            found.insert( item );
+
+                        for( SCH_ITEM* item : reference.Overlapping( type, bbox ) )
+                            expected.insert( item );
+
+                        BOOST_CHECK( found == expected );
+                    }
+                }
+            };
+
+    checkSameResults();
+
+    for( size_t i = 0; i < items.size(); i += 2 )
+    {
+        BOOST_CHECK( m_tree.remove( items[i] ) );
+        reference.remove( items[i] );
+    }
+
+    SCH_JUNCTION* junction = new SCH_JUNCTION( wxPoint( Mils2iu( 1000 ), Mils2iu( 1000 ) ) );
+    items.push_back( junction );
+    m_tree.insert( junction );
+    reference.insert( junction );
+
+    checkSameResults();
+
+    for( SCH_ITEM* item : items )
+        delete item;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
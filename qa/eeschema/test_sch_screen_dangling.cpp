@@ -0,0 +1,264 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for SCH_SCREEN::TestDanglingEnds()
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <convert_to_biu.h>
+#include <profile.h>
+#include <sch_bus_entry.h>
+#include <sch_junction.h>
+#include <sch_line.h>
+#include <sch_text.h>
+
+// Code under test
+#include <sch_screen.h>
+
+
+static const int GRID = Mils2iu( 100 );
+
+
+/**
+ * Add a serpentine wire chain of \a aCount segments.  Every \a aGapEvery segment is shortened
+ * so that it leaves two dangling ends.
+ */
+static void addWireChain( SCH_SCREEN& aScreen, int aCount, int aGapEvery )
+{
+    const int rowLength = 50;
+
+    for( int ii = 0; ii < aCount; ii++ )
+    {
+        int     row = ii / rowLength;
+        int     col = ii % rowLength;
+        wxPoint start( col * GRID, row * GRID );
+        wxPoint end( ( col + 1 ) * GRID, row * GRID );
+
+        // Connect the end of a row to the start of the next one with a diagonal
+        if( col == rowLength - 1 )
+            end = wxPoint( 0, ( row + 1 ) * GRID );
+
+        if( aGapEvery && ii % aGapEvery == aGapEvery - 1 )
+            end.x -= GRID / 2;
+
+        SCH_LINE* wire = new SCH_LINE( start, LAYER_WIRE );
+        wire->SetEndPoint( end );
+        aScreen.Append( wire );
+    }
+}
+
+
+/**
+ * Record the dangling state of every item, as computed against all end points of the screen.
+ */
+static std::vector<bool> referenceDanglingStates( SCH_SCREEN& aScreen )
+{
+    std::vector<DANGLING_END_ITEM> endPoints;
+    std::vector<bool>              states;
+
+    for( SCH_ITEM* item : aScreen.Items() )
+        item->GetEndPoints( endPoints );
+
+    for( SCH_ITEM* item : aScreen.Items() )
+    {
+        item->UpdateDanglingState( endPoints );
+
+        if( item->Type() == SCH_LINE_T )
+        {
+            states.push_back( static_cast<SCH_LINE*>( item )->IsStartDangling() );
+            states.push_back( static_cast<SCH_LINE*>( item )->IsEndDangling() );
+        }
+        else
+        {
+            states.push_back( item->IsDangling() );
+        }
+    }
+
+    return states;
+}
+
+
+static std::vector<bool> danglingStates( SCH_SCREEN& aScreen )
+{
+    std::vector<bool> states;
+
+    aScreen.TestDanglingEnds();
+
+    for( SCH_ITEM* item : aScreen.Items() )
+    {
+        if( item->Type() == SCH_LINE_T )
+        {
+            states.push_back( static_cast<SCH_LINE*>( item )->IsStartDangling() );
+            states.push_back( static_cast<SCH_LINE*>( item )->IsEndDangling() );
+        }
+        else
+        {
+            states.push_back( item->IsDangling() );
+        }
+    }
+
+    return states;
+}
+
+
+/**
+ * Wires, labels on wire ends and mid-segment, junctions and bus entries on a bus.
+ */
+static void addMixedItems( SCH_SCREEN& aScreen )
+{
+    addWireChain( aScreen, 2000, 7 );
+
+    // Labels on wire ends, in the middle of wires, and off any wire
+    for( int ii = 0; ii < 200; ii++ )
+    {
+        int row = ii / 10;
+        int col = ( ii % 10 ) * 5;
+
+        aScreen.Append( new SCH_LABEL( wxPoint( col * GRID, row * GRID ), "A" ) );
+        aScreen.Append( new SCH_LABEL( wxPoint( col * GRID + GRID / 4, row * GRID ), "B" ) );
+        aScreen.Append( new SCH_LABEL( wxPoint( col * GRID + GRID / 4, row * GRID + GRID / 2 ),
+                                      "C" ) );
+    }
+
+    for( int ii = 0; ii < 100; ii++ )
+        aScreen.Append( new SCH_JUNCTION( wxPoint( ii * 3 * GRID, 0 ) ) );
+
+    // A vertical bus with wire entries, half of them reaching a wire
+    SCH_LINE* bus = new SCH_LINE( wxPoint( -10 * GRID, 0 ), LAYER_BUS );
+    bus->SetEndPoint( wxPoint( -10 * GRID, 40 * GRID ) );
+    aScreen.Append( bus );
+
+    for( int ii = 0; ii < 40; ii++ )
+    {
+        SCH_BUS_WIRE_ENTRY* entry = new SCH_BUS_WIRE_ENTRY( wxPoint( -10 * GRID, ii * GRID ) );
+        aScreen.Append( entry );
+
+        if( ii % 2 )
+        {
+            SCH_LINE* wire = new SCH_LINE( entry->GetEnd(), LAYER_WIRE );
+            wire->SetEndPoint( entry->GetEnd() + wxPoint( GRID, 0 ) );
+            aScreen.Append( wire );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE( SchScreenDangling )
+
+
+/**
+ * A mix of items must give the same result as testing every item against every end point.
+ * The reference is computed on a separate, identical screen so that the flags it sets can't
+ * hide a missing update on the screen under test.
+ */
+BOOST_AUTO_TEST_CASE( MatchesExhaustiveTest )
+{
+    SCH_SCREEN reference;
+    SCH_SCREEN screen;
+
+    addMixedItems( reference );
+    addMixedItems( screen );
+
+    std::vector<bool> expected = referenceDanglingStates( reference );
+    std::vector<bool> result = danglingStates( screen );
+
+    BOOST_CHECK( expected == result );
+}
+
+
+/**
+ * Long diagonal wires and buses, with labels on and near them.
+ */
+BOOST_AUTO_TEST_CASE( MatchesExhaustiveTestDiagonals )
+{
+    SCH_SCREEN reference;
+    SCH_SCREEN screen;
+
+    for( SCH_SCREEN* s : { &reference, &screen } )
+    {
+        addWireChain( *s, 500, 3 );
+
+        for( int ii = 0; ii < 20; ii++ )
+        {
+            SCH_LINE* wire = new SCH_LINE( wxPoint( ii * GRID, 0 ), ii % 2 ? LAYER_BUS
+                                                                          : LAYER_WIRE );
+            wire->SetEndPoint( wxPoint( ( ii + 30 ) * GRID, ( 40 - ii ) * GRID ) );
+            s->Append( wire );
+
+            // On the wire, next to it, and on one of its ends
+            s->Append( new SCH_LABEL( wire->GetStartPoint() + ( wire->GetEndPoint()
+                                                                - wire->GetStartPoint() ) / 2,
+                                      "D" ) );
+            s->Append( new SCH_LABEL( wire->GetStartPoint() + wxPoint( GRID / 3, 0 ), "E" ) );
+            s->Append( new SCH_LABEL( wire->GetEndPoint(), "F" ) );
+        }
+    }
+
+    std::vector<bool> expected = referenceDanglingStates( reference );
+    std::vector<bool> result = danglingStates( screen );
+
+    BOOST_CHECK( expected == result );
+}
+
+
+/**
+ * Dangling end detection on a sheet with 50k wires.
+ */
+BOOST_AUTO_TEST_CASE( LargeSheet )
+{
+    const int wireCount = 50000;
+    const int gapEvery = 100;
+
+    SCH_SCREEN screen;
+
+    addWireChain( screen, wireCount, gapEvery );
+
+    PROF_COUNTER timer;
+
+    screen.TestDanglingEnds();
+
+    timer.Stop();
+
+    BOOST_TEST_MESSAGE( "TestDanglingEnds() on " << wireCount << " wires: "
+                        << timer.msecs() << " ms" );
+
+    int dangling = 0;
+
+    for( SCH_ITEM* item : screen.Items() )
+    {
+        SCH_LINE* wire = static_cast<SCH_LINE*>( item );
+        dangling += wire->IsStartDangling() + wire->IsEndDangling();
+    }
+
+    // Every gap leaves two dangling ends, except the last one which ends the chain and only
+    // leaves one.  The start of the chain is dangling too.
+    int expected = 2 * ( wireCount / gapEvery );
+
+    BOOST_CHECK_EQUAL( dangling, expected );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
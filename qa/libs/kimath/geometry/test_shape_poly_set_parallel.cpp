@@ -0,0 +1,135 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include "geom_test_utils.h"
+
+
+/**
+ * Build a grid of overlapping squares.  The squares are axis-aligned so the union has no
+ * rounded intersection points and its area can be compared exactly.
+ */
+static SHAPE_POLY_SET buildSquareGrid( int aCount, int aSize, int aPitch )
+{
+    SHAPE_POLY_SET grid;
+
+    for( int ix = 0; ix < aCount; ix++ )
+    {
+        for( int iy = 0; iy < aCount; iy++ )
+        {
+            SHAPE_LINE_CHAIN square;
+            int              x = ix * aPitch;
+            int              y = iy * aPitch;
+
+            square.Append( x, y );
+            square.Append( x + aSize, y );
+            square.Append( x + aSize, y + aSize );
+            square.Append( x, y + aSize );
+            square.SetClosed( true );
+
+            grid.AddOutline( square );
+        }
+    }
+
+    return grid;
+}
+
+
+/**
+ * Build a grid of clusters of overlapping squares, with gaps between the clusters.
+ */
+static SHAPE_POLY_SET buildClusterGrid( int aCount )
+{
+    const int      clusterPitch = 5000;
+    SHAPE_POLY_SET clusters;
+
+    for( int ix = 0; ix < aCount; ix++ )
+    {
+        for( int iy = 0; iy < aCount; iy++ )
+        {
+            SHAPE_POLY_SET cluster = buildSquareGrid( 3, 1000, 700 );
+            cluster.Move( VECTOR2I( ix * clusterPitch, iy * clusterPitch ) );
+            clusters.Append( cluster );
+        }
+    }
+
+    return clusters;
+}
+
+
+BOOST_AUTO_TEST_SUITE( ParallelPolyBoolean )
+
+
+/**
+ * Check that the parallel union covers exactly the same area as the serial one
+ */
+BOOST_AUTO_TEST_CASE( ParallelSimplifyMatchesSerial )
+{
+    const std::vector<std::pair<std::string, SHAPE_POLY_SET>> cases = {
+        // Overlapping squares which all merge into a single outline
+        { "overlapping", buildSquareGrid( 40, 1000, 700 ) },
+        // Clusters of overlapping squares with gaps between them, so the result has several
+        // outlines and the partial results of the threads are disjoint
+        { "clusters", buildClusterGrid( 12 ) },
+    };
+
+    for( const auto& c : cases )
+    {
+        SHAPE_POLY_SET serial = c.second;
+
+        serial.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+        if( c.first == "clusters" )
+            BOOST_CHECK_EQUAL( serial.OutlineCount(), 12 * 12 );
+
+        for( size_t threads : { 1, 2, 3, 8 } )
+        {
+            BOOST_TEST_CONTEXT( c.first << ", threads: " << threads )
+            {
+                SHAPE_POLY_SET testPoly = c.second;
+                testPoly.ParallelSimplify( SHAPE_POLY_SET::PM_FAST, threads );
+
+                BOOST_CHECK( GEOM_TEST::IsPolySetValid( testPoly ) );
+                BOOST_CHECK_EQUAL( testPoly.OutlineCount(), serial.OutlineCount() );
+                BOOST_CHECK_EQUAL( testPoly.Area(), serial.Area() );
+
+                // Equal areas could still hide shifted vertices: the differences must be empty
+                SHAPE_POLY_SET extra = testPoly;
+                SHAPE_POLY_SET missing = serial;
+
+                extra.BooleanSubtract( serial, SHAPE_POLY_SET::PM_FAST );
+                missing.BooleanSubtract( testPoly, SHAPE_POLY_SET::PM_FAST );
+
+                BOOST_CHECK_EQUAL( extra.Area(), 0.0 );
+                BOOST_CHECK_EQUAL( missing.Area(), 0.0 );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
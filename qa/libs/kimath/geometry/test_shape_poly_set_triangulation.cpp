@@ -0,0 +1,191 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <set>
+
+
+/**
+ * Build a row of disjoint squares, each with a square hole.
+ */
+static SHAPE_POLY_SET buildHoleyRow( int aCount )
+{
+    SHAPE_POLY_SET row;
+
+    for( int ii = 0; ii < aCount; ii++ )
+    {
+        SHAPE_LINE_CHAIN outline;
+        int              x = ii * 3000;
+
+        outline.Append( x, 0 );
+        outline.Append( x + 2000, 0 );
+        outline.Append( x + 2000, 2000 );
+        outline.Append( x, 2000 );
+        outline.SetClosed( true );
+
+        SHAPE_LINE_CHAIN hole;
+
+        hole.Append( x + 500, 500 );
+        hole.Append( x + 500, 1500 );
+        hole.Append( x + 1500, 1500 );
+        hole.Append( x + 1500, 500 );
+        hole.SetClosed( true );
+
+        int idx = row.AddOutline( outline );
+        row.AddHole( hole, idx );
+    }
+
+    return row;
+}
+
+
+static double triangulatedArea( const SHAPE_POLY_SET& aPoly )
+{
+    double area = 0.0;
+
+    for( unsigned ii = 0; ii < aPoly.TriangulatedPolyCount(); ii++ )
+    {
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = aPoly.TriangulatedPolygon( ii );
+
+        for( size_t jj = 0; jj < tri->GetTriangleCount(); jj++ )
+        {
+            VECTOR2I a, b, c;
+            tri->GetTriangle( jj, a, b, c );
+
+            area += std::abs( (double) ( b - a ).Cross( c - a ) ) / 2.0;
+        }
+    }
+
+    return area;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PolySetTriangulation )
+
+
+/**
+ * Check that the triangulation covers the polygons and tracks modifications
+ */
+BOOST_AUTO_TEST_CASE( CacheTracksChanges )
+{
+    SHAPE_POLY_SET poly = buildHoleyRow( 10 );
+
+    BOOST_CHECK( !poly.IsTriangulationUpToDate() );
+
+    poly.CacheTriangulation( false );
+
+    BOOST_CHECK( poly.IsTriangulationUpToDate() );
+    BOOST_CHECK_CLOSE( triangulatedArea( poly ), poly.Area(), 0.001 );
+
+    poly.Outline( 3 ).SetPoint( 0, VECTOR2I( 9000, -100 ) );
+
+    BOOST_CHECK( !poly.IsTriangulationUpToDate() );
+
+    poly.CacheTriangulation( false );
+
+    BOOST_CHECK( poly.IsTriangulationUpToDate() );
+    BOOST_CHECK_CLOSE( triangulatedArea( poly ), poly.Area(), 0.001 );
+
+    // A move keeps the triangulation valid, as do copies
+    poly.Move( VECTOR2I( 100, 200 ) );
+
+    BOOST_CHECK( poly.IsTriangulationUpToDate() );
+
+    SHAPE_POLY_SET copy = poly;
+
+    BOOST_CHECK( copy.IsTriangulationUpToDate() );
+    BOOST_CHECK_CLOSE( triangulatedArea( copy ), poly.Area(), 0.001 );
+
+    // Moving stale triangles doesn't make them valid, and those which are not stale are reused
+    // at their new position
+    poly.Outline( 0 ).SetPoint( 0, VECTOR2I( 0, 100 ) );
+    poly.Move( VECTOR2I( -300, 50 ) );
+
+    BOOST_CHECK( !poly.IsTriangulationUpToDate() );
+
+    poly.CacheTriangulation( false );
+
+    BOOST_CHECK( poly.IsTriangulationUpToDate() );
+    BOOST_CHECK_CLOSE( triangulatedArea( poly ), poly.Area(), 0.001 );
+}
+
+
+/**
+ * Check that only the modified polygons are triangulated again
+ */
+BOOST_AUTO_TEST_CASE( CacheReusesUnchangedPolygons )
+{
+    SHAPE_POLY_SET poly = buildHoleyRow( 10 );
+
+    poly.CacheTriangulation( false );
+
+    std::set<const SHAPE_POLY_SET::TRIANGULATED_POLYGON*> before;
+
+    for( unsigned ii = 0; ii < poly.TriangulatedPolyCount(); ii++ )
+        before.insert( poly.TriangulatedPolygon( ii ) );
+
+    poly.Outline( 3 ).SetPoint( 0, VECTOR2I( 9000, -100 ) );
+    poly.CacheTriangulation( false );
+
+    unsigned reused = 0;
+
+    for( unsigned ii = 0; ii < poly.TriangulatedPolyCount(); ii++ )
+    {
+        if( before.count( poly.TriangulatedPolygon( ii ) ) )
+            reused++;
+    }
+
+    // Every polygon but the modified one keeps its triangles
+    BOOST_CHECK_EQUAL( reused, poly.TriangulatedPolyCount() - 1 );
+}
+
+
+/**
+ * Check that the threaded triangulation gives the same triangles as the serial one
+ */
+BOOST_AUTO_TEST_CASE( ThreadedMatchesSerial )
+{
+    // Enough points to be spread over several threads
+    SHAPE_POLY_SET serial = buildHoleyRow( 5000 );
+    SHAPE_POLY_SET threaded = serial;
+
+    serial.CacheTriangulation( false );
+    threaded.CacheTriangulation( false, true );
+
+    BOOST_CHECK( threaded.IsTriangulationUpToDate() );
+    BOOST_REQUIRE_EQUAL( threaded.TriangulatedPolyCount(), serial.TriangulatedPolyCount() );
+
+    for( unsigned ii = 0; ii < serial.TriangulatedPolyCount(); ii++ )
+    {
+        BOOST_CHECK_EQUAL( threaded.TriangulatedPolygon( ii )->GetTriangleCount(),
+                           serial.TriangulatedPolygon( ii )->GetTriangleCount() );
+    }
+
+    BOOST_CHECK_CLOSE( triangulatedArea( threaded ), serial.Area(), 0.001 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the footprint library cache of the KiCad s-expression plugin.
+ */
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <footprint.h>
+#include <wildcards_and_files_ext.h>
+#include <wx/datetime.h>
+#include <wx/filename.h>
+
+// Code under test
+#include <plugins/kicad/kicad_plugin.h>
+
+
+class FP_CACHE_FIXTURE
+{
+public:
+    FP_CACHE_FIXTURE()
+    {
+        m_libPath = boost::filesystem::temp_directory_path()
+                    / boost::filesystem::unique_path( "qa_fp_cache_%%%%-%%%%.pretty" );
+        boost::filesystem::create_directory( m_libPath );
+    }
+
+    ~FP_CACHE_FIXTURE()
+    {
+        boost::filesystem::remove_all( m_libPath );
+    }
+
+    wxString libPath() const { return wxString( m_libPath.string() ); }
+
+    wxString footprintFile( const wxString& aName ) const
+    {
+        return wxFileName( libPath(), aName, KiCadFootprintFileExtension ).GetFullPath();
+    }
+
+    /**
+     * Write a footprint file, with a modification time \a aAge seconds in the past so that
+     * rewriting it is always seen as a change.
+     */
+    void writeFootprint( const wxString& aName, const std::string& aContents, int aAge )
+    {
+        wxString fileName = footprintFile( aName );
+
+        {
+            std::ofstream out( fileName.fn_str() );
+            out << aContents;
+        }
+
+        wxDateTime modTime = wxDateTime::Now() - wxTimeSpan::Seconds( aAge );
+        wxFileName( fileName ).SetTimes( nullptr, &modTime, nullptr );
+    }
+
+    static std::string footprintContents( const std::string& aName, const std::string& aDescr )
+    {
+        return "(footprint \"" + aName + "\" (version 20210623) (generator pcbnew)\n"
+               "  (layer \"F.Cu\")\n"
+               "  (descr \"" + aDescr + "\")\n"
+               ")\n";
+    }
+
+    boost::filesystem::path m_libPath;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( FpCache, FP_CACHE_FIXTURE )
+
+
+/**
+ * Enumeration only lists the files: broken footprint files are only reported once they have
+ * been loaded or the library has been prefetched.  The valid footprints are still listed.
+ */
+BOOST_AUTO_TEST_CASE( LazyLoad )
+{
+    writeFootprint( "A", footprintContents( "A", "a" ), 60 );
+    writeFootprint( "B", footprintContents( "B", "b" ), 60 );
+    writeFootprint( "Broken", "(footprint \"Broken\"", 60 );
+
+    PCB_IO        io;
+    wxArrayString names;
+
+    BOOST_CHECK_NO_THROW( io.FootprintEnumerate( names, libPath(), false ) );
+    BOOST_CHECK_EQUAL( names.size(), 3 );
+
+    const FOOTPRINT* a = io.GetEnumeratedFootprint( libPath(), "A" );
+
+    BOOST_REQUIRE( a );
+    BOOST_CHECK_EQUAL( a->GetDescription(), "a" );
+    BOOST_CHECK_THROW( io.GetEnumeratedFootprint( libPath(), "Broken" ), IO_ERROR );
+
+    BOOST_CHECK_NO_THROW( io.PrefetchLib( libPath() ) );
+
+    // The broken file is now reported, but the valid footprints are still enumerated
+    names.clear();
+    BOOST_CHECK_THROW( io.FootprintEnumerate( names, libPath(), false ), IO_ERROR );
+    BOOST_CHECK_EQUAL( names.size(), 2 );
+
+    names.clear();
+    BOOST_CHECK_NO_THROW( io.FootprintEnumerate( names, libPath(), true ) );
+    BOOST_REQUIRE_EQUAL( names.size(), 2 );
+    BOOST_CHECK( names.Index( "A" ) != wxNOT_FOUND );
+    BOOST_CHECK( names.Index( "B" ) != wxNOT_FOUND );
+
+    BOOST_CHECK( io.GetEnumeratedFootprint( libPath(), "B" ) != nullptr );
+
+    // Fixing the broken file makes it available again
+    writeFootprint( "Broken", footprintContents( "Broken", "fixed" ), 30 );
+
+    names.clear();
+    BOOST_CHECK_NO_THROW( io.FootprintEnumerate( names, libPath(), false ) );
+    BOOST_CHECK_EQUAL( names.size(), 3 );
+    BOOST_CHECK( io.GetEnumeratedFootprint( libPath(), "Broken" ) != nullptr );
+}
+
+
+/**
+ * A modified library only reloads the footprint files which changed.
+ */
+BOOST_AUTO_TEST_CASE( IncrementalReload )
+{
+    writeFootprint( "A", footprintContents( "A", "a" ), 60 );
+    writeFootprint( "B", footprintContents( "B", "b" ), 60 );
+    writeFootprint( "C", footprintContents( "C", "c" ), 60 );
+
+    PCB_IO io;
+
+    io.PrefetchLib( libPath() );
+
+    const FOOTPRINT* a = io.GetEnumeratedFootprint( libPath(), "A" );
+    BOOST_REQUIRE( a );
+
+    writeFootprint( "B", footprintContents( "B", "b2" ), 30 );
+    wxRemoveFile( footprintFile( "C" ) );
+
+    std::unique_ptr<FOOTPRINT> b( io.FootprintLoad( libPath(), "B" ) );
+
+    BOOST_REQUIRE( b );
+    BOOST_CHECK_EQUAL( b->GetDescription(), "b2" );
+
+    // Unchanged footprints are not parsed again
+    BOOST_CHECK( io.GetEnumeratedFootprint( libPath(), "A" ) == a );
+
+    wxArrayString names;
+    io.FootprintEnumerate( names, libPath(), false );
+
+    BOOST_CHECK_EQUAL( names.size(), 2 );
+    BOOST_CHECK( io.FootprintLoad( libPath(), "C" ) == nullptr );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_effective_shape_cache.cpp
+ * Test suite for BOARD::GetCachedEffectiveShape() and BOARD::InvalidateEffectiveShape()
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <board.h>
+#include <pcb_track.h>
+#include <geometry/shape_segment.h>
+
+
+class EFFECTIVE_SHAPE_CACHE_FIXTURE
+{
+public:
+    EFFECTIVE_SHAPE_CACHE_FIXTURE()
+    {
+        m_board = std::make_unique<BOARD>();
+
+        m_track = new PCB_TRACK( m_board.get() );
+        m_track->SetStart( wxPoint( 0, 0 ) );
+        m_track->SetEnd( wxPoint( 1000000, 0 ) );
+        m_track->SetWidth( 250000 );
+        m_track->SetLayer( F_Cu );
+
+        m_board->Add( m_track );
+    }
+
+    /// @return the cached shape of the track, as a segment.
+    SEG cachedSeg()
+    {
+        std::shared_ptr<SHAPE> shape = m_board->GetCachedEffectiveShape( m_track );
+
+        BOOST_REQUIRE( shape && shape->Type() == SH_SEGMENT );
+        return static_cast<SHAPE_SEGMENT*>( shape.get() )->GetSeg();
+    }
+
+    std::unique_ptr<BOARD> m_board;
+    PCB_TRACK*             m_track;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( EffectiveShapeCache, EFFECTIVE_SHAPE_CACHE_FIXTURE )
+
+
+/**
+ * The shape is only built once while the track is unchanged.
+ */
+BOOST_AUTO_TEST_CASE( Cached )
+{
+    std::shared_ptr<SHAPE> shape = m_board->GetCachedEffectiveShape( m_track );
+
+    BOOST_CHECK( shape == m_board->GetCachedEffectiveShape( m_track ) );
+    BOOST_CHECK( cachedSeg() == SEG( VECTOR2I( 0, 0 ), VECTOR2I( 1000000, 0 ) ) );
+}
+
+
+/**
+ * A track modified through a commit gets a new shape.
+ *
+ * BOARD_COMMIT::Push() needs an edit frame and its tools, which the tests cannot build, so the
+ * board calls it makes for a modified item are done here directly.
+ */
+BOOST_AUTO_TEST_CASE( ModifiedThroughCommit )
+{
+    std::shared_ptr<SHAPE> shape = m_board->GetCachedEffectiveShape( m_track );
+
+    std::vector<BOARD_ITEM*> itemsChanged = { m_track };
+
+    m_track->Move( wxPoint( 0, 500000 ) );
+    m_board->InvalidateEffectiveShape( m_track );
+    m_board->OnItemsChanged( itemsChanged );
+
+    BOOST_CHECK( shape != m_board->GetCachedEffectiveShape( m_track ) );
+    BOOST_CHECK( cachedSeg() == SEG( VECTOR2I( 0, 500000 ), VECTOR2I( 1000000, 500000 ) ) );
+
+    // The end of the commit is enough, even when the bounding box is unchanged
+    m_track->SetStart( wxPoint( 1000000, 500000 ) );
+    m_track->SetEnd( wxPoint( 0, 500000 ) );
+    m_board->OnItemsChanged( itemsChanged );
+
+    BOOST_CHECK( cachedSeg() == SEG( VECTOR2I( 1000000, 500000 ), VECTOR2I( 0, 500000 ) ) );
+}
+
+
+/**
+ * A track moved without a commit is detected by its bounding box; a change keeping the
+ * bounding box needs an explicit InvalidateEffectiveShape().
+ */
+BOOST_AUTO_TEST_CASE( ModifiedWithoutCommit )
+{
+    cachedSeg();
+
+    m_track->Move( wxPoint( 0, 500000 ) );
+
+    BOOST_CHECK( cachedSeg() == SEG( VECTOR2I( 0, 500000 ), VECTOR2I( 1000000, 500000 ) ) );
+
+    // Same bounding box
+    m_track->SetStart( wxPoint( 1000000, 500000 ) );
+    m_track->SetEnd( wxPoint( 0, 500000 ) );
+
+    BOOST_CHECK( cachedSeg() == SEG( VECTOR2I( 0, 500000 ), VECTOR2I( 1000000, 500000 ) ) );
+
+    m_board->InvalidateEffectiveShape( m_track );
+
+    BOOST_CHECK( cachedSeg() == SEG( VECTOR2I( 1000000, 500000 ), VECTOR2I( 0, 500000 ) ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
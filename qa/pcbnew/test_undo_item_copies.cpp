@@ -0,0 +1,216 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_undo_item_copies.cpp
+ * Test suite for the #UNDO_ITEM_COPIES class
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <undo_item_copies.h> // UUT
+
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <undo_redo_container.h>
+
+
+/**
+ * Undo and redo lists handled the same way as by #PCB_BASE_EDIT_FRAME, with a given budget.
+ */
+class UNDO_ITEM_COPIES_FIXTURE
+{
+public:
+    UNDO_ITEM_COPIES_FIXTURE() :
+            m_budget( 10 )
+    {
+    }
+
+    ~UNDO_ITEM_COPIES_FIXTURE()
+    {
+        clearUndo( -1 );
+        clearList( m_redoList, -1 );
+    }
+
+    /// A command holding copies of \a aCount tracks
+    static PICKED_ITEMS_LIST* tracksCommand( int aCount )
+    {
+        PICKED_ITEMS_LIST* command = new PICKED_ITEMS_LIST();
+
+        for( int ii = 0; ii < aCount; ++ii )
+        {
+            command->PushItem( ITEM_PICKER( nullptr, new PCB_TRACK( nullptr ),
+                                            UNDO_REDO::DELETED ) );
+        }
+
+        return command;
+    }
+
+    /// A command holding the copy of a footprint with two pads, which counts as 5 copies
+    static PICKED_ITEMS_LIST* footprintCommand()
+    {
+        PICKED_ITEMS_LIST* command = new PICKED_ITEMS_LIST();
+        FOOTPRINT*         footprint = new FOOTPRINT( nullptr );
+
+        footprint->Add( new PAD( footprint ) );
+        footprint->Add( new PAD( footprint ) );
+
+        command->PushItem( ITEM_PICKER( nullptr, footprint, UNDO_REDO::DELETED ) );
+        return command;
+    }
+
+    /// See PCB_BASE_EDIT_FRAME::PushCommandToUndoList()
+    void pushUndo( PICKED_ITEMS_LIST* aCommand )
+    {
+        m_copies.Add( aCommand );
+        m_undoList.PushCommand( aCommand );
+
+        if( m_copies.GetTotal() > m_budget )
+            clearUndo( m_copies.ExcessCommands( m_undoList, m_budget ) );
+    }
+
+    /// See PCB_BASE_EDIT_FRAME::PopCommandFromUndoList()
+    PICKED_ITEMS_LIST* popUndo()
+    {
+        PICKED_ITEMS_LIST* command = m_undoList.PopCommand();
+
+        if( command )
+            m_copies.Remove( command );
+
+        return command;
+    }
+
+    /// See PCB_BASE_EDIT_FRAME::ClearUndoORRedoList()
+    void clearUndo( int aCount )
+    {
+        clearList( m_undoList, aCount );
+    }
+
+    void clearList( UNDO_REDO_CONTAINER& aList, int aCount )
+    {
+        if( aCount == 0 )
+            return;
+
+        unsigned count = aCount > 0 ? aCount : aList.m_CommandsList.size();
+
+        for( unsigned ii = 0; ii < count && !aList.m_CommandsList.empty(); ++ii )
+        {
+            PICKED_ITEMS_LIST* command = aList.m_CommandsList[0];
+            aList.m_CommandsList.erase( aList.m_CommandsList.begin() );
+
+            if( &aList == &m_undoList )
+                m_copies.Remove( command );
+
+            command->ClearListAndDeleteItems();
+            delete command;
+        }
+    }
+
+    /// Undo the last command, as PCB_BASE_EDIT_FRAME::RestoreCopyFromUndoList() does
+    void undo() { m_redoList.PushCommand( popUndo() ); }
+
+    /// Redo the last command, as PCB_BASE_EDIT_FRAME::RestoreCopyFromRedoList() does
+    void redo() { pushUndo( m_redoList.PopCommand() ); }
+
+    size_t              m_budget;
+    UNDO_ITEM_COPIES    m_copies;
+    UNDO_REDO_CONTAINER m_undoList;
+    UNDO_REDO_CONTAINER m_redoList;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( UndoItemCopies, UNDO_ITEM_COPIES_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( PushPopRedoClear )
+{
+    pushUndo( tracksCommand( 4 ) );
+    pushUndo( tracksCommand( 4 ) );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 8 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 2 );
+
+    // 13 copies: the oldest command is dropped
+    pushUndo( footprintCommand() );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 9 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 2 );
+
+    undo();
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 4 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 1 );
+    BOOST_CHECK_EQUAL( m_redoList.m_CommandsList.size(), 1 );
+
+    redo();
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 9 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 2 );
+    BOOST_CHECK_EQUAL( m_redoList.m_CommandsList.size(), 0 );
+
+    // 17 copies: both older commands are dropped
+    pushUndo( tracksCommand( 8 ) );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 8 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 1 );
+
+    // The most recent command is kept, even when over budget
+    pushUndo( tracksCommand( 12 ) );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 12 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 1 );
+
+    clearUndo( -1 );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 0 );
+    BOOST_CHECK_EQUAL( m_undoList.m_CommandsList.size(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( PopAll )
+{
+    pushUndo( tracksCommand( 2 ) );
+    pushUndo( footprintCommand() );
+    pushUndo( tracksCommand( 3 ) );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 10 );
+
+    while( !m_undoList.m_CommandsList.empty() )
+        undo();
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 0 );
+    BOOST_CHECK_EQUAL( m_redoList.m_CommandsList.size(), 3 );
+
+    // Forgetting a command which is not counted changes nothing
+    PICKED_ITEMS_LIST* command = tracksCommand( 1 );
+    m_copies.Remove( command );
+
+    BOOST_CHECK_EQUAL( m_copies.GetTotal(), 0 );
+
+    command->ClearListAndDeleteItems();
+    delete command;
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,613 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <cerrno>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include <wx/cmdline.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <convert_to_biu.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <exporters/gendrill_Excellon_writer.h>
+#include <io_mgr.h>
+#include <locale_io.h>
+#include <pcb_marker.h>
+#include <pcbplot.h>
+#include <plotcontroller.h>
+#include <profile.h>
+#include <project.h>
+#include <settings/settings_manager.h>
+#include <wildcards_and_files_ext.h>
+#include <zone.h>
+#include <zone_filler.h>
+
+
+/// Ordered by severity: the most severe failure of a batch is reported
+enum PCB_BATCH_RET_CODES
+{
+    DRC_ERRORS = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    PLOT_FAILED,
+    LOAD_FAILED,
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "o", "output",
+            _( "output directory (default: next to each board)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "j", "jobs", _( "number of boards processed at once" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "r", "report", _( "JSON report file (default: stdout)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_SWITCH, "", "no-fill", _( "do not refill the zones" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "", "no-drc", _( "do not run the design rules checks" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "", "no-plot", _( "do not plot the fabrication files" ).mb_str() },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board files or directories" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+struct BATCH_OPTIONS
+{
+    wxString m_outputDir;
+    bool     m_fillZones = true;
+    bool     m_runDRC = true;
+    bool     m_plot = true;
+};
+
+
+/**
+ * @return the peak resident memory of the process in kB, or -1 when it is not available.
+ *
+ * This is the high-water mark of the whole process lifetime, not of a single stage: it is only
+ * meaningful once per process, i.e. once per board since each board gets its own process when
+ * several are processed.
+ */
+static long peakMemoryKb()
+{
+#ifdef _WIN32
+    return -1;
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return -1;
+
+#ifdef __APPLE__
+    // macOS reports bytes, everybody else kilobytes
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+
+static nlohmann::json stageReport( const std::string& aName, PROF_COUNTER& aTimer )
+{
+    aTimer.Stop();
+
+    return { { "name", aName }, { "ms", aTimer.msecs() } };
+}
+
+
+/**
+ * @return the directory receiving the plots of \a aBoardFile.  With a common output directory,
+ *         each board gets a sub-directory named after the board and a hash of the directory
+ *         holding it, so that boards with the same name in different directories don't
+ *         overwrite each other's plots.
+ */
+static wxString outputDirFor( const wxFileName& aBoardFile, const BATCH_OPTIONS& aOptions )
+{
+    if( aOptions.m_outputDir.IsEmpty() )
+        return aBoardFile.GetPath();
+
+    size_t   pathHash = std::hash<std::string>()( std::string( aBoardFile.GetPath().ToUTF8() ) );
+    wxString subDir = wxString::Format( wxT( "%s-%08x" ), aBoardFile.GetName(),
+                                        (unsigned int) ( pathHash & 0xFFFFFFFF ) );
+
+    wxFileName dir = wxFileName::DirName( aOptions.m_outputDir );
+    dir.AppendDir( subDir );
+
+    return dir.GetPath();
+}
+
+
+static bool plotBoard( BOARD* aBoard, const wxString& aOutputDir, nlohmann::json& aFiles )
+{
+    PLOT_CONTROLLER plotter( aBoard );
+
+    plotter.GetPlotOptions() = aBoard->GetPlotOptions();
+    plotter.GetPlotOptions().SetOutputDirectory( aOutputDir );
+
+    LSET fabLayers = LSET::AllCuMask() | LSET( 7, F_SilkS, B_SilkS, F_Mask, B_Mask, F_Paste,
+                                               B_Paste, Edge_Cuts );
+
+    for( PCB_LAYER_ID layer : ( aBoard->GetEnabledLayers() & fabLayers ).Seq() )
+    {
+        plotter.SetLayer( layer );
+
+        if( !plotter.OpenPlotfile( aBoard->GetLayerName( layer ), PLOT_FORMAT::GERBER,
+                                   aBoard->GetLayerName( layer ) ) )
+        {
+            return false;
+        }
+
+        plotter.PlotLayer();
+        aFiles.push_back( std::string( plotter.GetPlotFileName().ToUTF8() ) );
+    }
+
+    plotter.ClosePlot();
+
+    EXCELLON_WRITER drillWriter( aBoard );
+
+    drillWriter.SetFormat( true );
+    drillWriter.SetOptions( false, false, aBoard->GetDesignSettings().m_AuxOrigin, false );
+    drillWriter.CreateDrillandMapFilesSet( aOutputDir, true, false );
+
+    return true;
+}
+
+
+/**
+ * Load a board and run the requested stages on it, reusing the same BOARD for all of them.
+ *
+ * @return one of the tool return codes; the report is filled in in any case.
+ */
+static int processBoard( const wxString& aFileName, const BATCH_OPTIONS& aOptions,
+                         nlohmann::json& aReport )
+{
+    wxFileName boardFile( aFileName );
+    boardFile.MakeAbsolute();
+
+    wxFileName pro( boardFile );
+    pro.SetExt( ProjectFileExtension );
+
+    aReport["board"] = std::string( boardFile.GetFullPath().ToUTF8() );
+    aReport["stages"] = nlohmann::json::array();
+
+    LOCALE_IO        dummy;
+    SETTINGS_MANAGER manager( true );
+    PROF_COUNTER     loadTimer;
+
+    manager.LoadProject( pro.GetFullPath() );
+
+    std::unique_ptr<BOARD> board;
+
+    try
+    {
+        board.reset( IO_MGR::Load( IO_MGR::KICAD_SEXP, boardFile.GetFullPath() ) );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        aReport["error"] = std::string( ioe.What().ToUTF8() );
+    }
+
+    if( !board )
+        return PCB_BATCH_RET_CODES::LOAD_FAILED;
+
+    board->SetProject( &manager.Prj() );
+
+    BOARD_DESIGN_SETTINGS& bds = board->GetDesignSettings();
+    bds.m_DRCEngine = std::make_shared<DRC_ENGINE>( board.get(), &bds );
+
+    board->BuildConnectivity();
+    board->BuildListOfNets();
+    board->SynchronizeNetsAndNetClasses();
+
+    aReport["stages"].push_back( stageReport( "load", loadTimer ) );
+
+    if( aOptions.m_fillZones )
+    {
+        PROF_COUNTER       fillTimer;
+        ZONE_FILLER        filler( board.get(), nullptr );
+        std::vector<ZONE*> zones = board->Zones();
+
+        filler.Fill( zones );
+        board->BuildConnectivity();
+
+        aReport["stages"].push_back( stageReport( "fill_zones", fillTimer ) );
+    }
+
+    int retCode = KI_TEST::RET_CODES::OK;
+
+    if( aOptions.m_runDRC )
+    {
+        PROF_COUNTER   drcTimer;
+        nlohmann::json violations = nlohmann::json::array();
+        int            errorCount = 0;
+
+        wxFileName rules( pro );
+        rules.SetExt( DesignRulesFileExtension );
+
+        try
+        {
+            bds.m_DRCEngine->InitEngine( rules );
+        }
+        catch( PARSE_ERROR& pe )
+        {
+            aReport["error"] = std::string( pe.What().ToUTF8() );
+            return PCB_BATCH_RET_CODES::LOAD_FAILED;
+        }
+
+        bds.m_DRCEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
+                {
+                    PCB_MARKER marker( aItem, aPos );
+                    SEVERITY   severity = bds.GetSeverity( aItem->GetErrorCode() );
+
+                    if( bds.m_DrcExclusions.count( marker.Serialize() ) )
+                        severity = RPT_SEVERITY_EXCLUSION;
+                    else if( severity == RPT_SEVERITY_ERROR )
+                        errorCount++;
+
+                    nlohmann::json items = nlohmann::json::array();
+
+                    for( const KIID& id : { aItem->GetMainItemID(), aItem->GetAuxItemID(),
+                                            aItem->GetAuxItem2ID(), aItem->GetAuxItem3ID() } )
+                    {
+                        if( id != niluuid )
+                            items.push_back( std::string( id.AsString().ToUTF8() ) );
+                    }
+
+                    violations.push_back( {
+                            { "type", std::string( aItem->GetSettingsKey().ToUTF8() ) },
+                            { "severity", std::string( SeverityToString( severity ).ToUTF8() ) },
+                            { "description", std::string( aItem->GetErrorMessage().ToUTF8() ) },
+                            { "x_mm", Iu2Millimeter( aPos.x ) },
+                            { "y_mm", Iu2Millimeter( aPos.y ) },
+                            { "items", items } } );
+                } );
+
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+        bds.m_DRCEngine->ClearViolationHandler();
+
+        aReport["violations"] = violations;
+        aReport["stages"].push_back( stageReport( "drc", drcTimer ) );
+
+        if( errorCount > 0 )
+            retCode = PCB_BATCH_RET_CODES::DRC_ERRORS;
+    }
+
+    if( aOptions.m_plot )
+    {
+        PROF_COUNTER   plotTimer;
+        nlohmann::json files = nlohmann::json::array();
+
+        if( !plotBoard( board.get(), outputDirFor( boardFile, aOptions ), files ) )
+            retCode = PCB_BATCH_RET_CODES::PLOT_FAILED;
+
+        aReport["plot_files"] = files;
+        aReport["stages"].push_back( stageReport( "plot", plotTimer ) );
+    }
+
+    long peak = peakMemoryKb();
+
+    if( peak >= 0 )
+        aReport["process_peak_rss_kb"] = peak;
+
+    aReport["result"] = retCode;
+
+    return retCode;
+}
+
+
+#ifdef _WIN32
+/**
+ * Quote an argument following the CommandLineToArgvW() rules, as _wspawnv() only joins its
+ * arguments with spaces.
+ */
+static wxString quoteWindowsArg( const wxString& aArg )
+{
+    wxString quoted = wxT( "\"" );
+    size_t   backslashes = 0;
+
+    for( wxUniChar c : aArg )
+    {
+        if( c == '\\' )
+        {
+            backslashes++;
+            continue;
+        }
+
+        // Backslashes are only escaped when they precede a quote
+        if( c == '"' )
+            quoted.Append( '\\', backslashes * 2 + 1 );
+        else
+            quoted.Append( '\\', backslashes );
+
+        backslashes = 0;
+        quoted += c;
+    }
+
+    quoted.Append( '\\', backslashes * 2 );
+
+    return quoted + wxT( "\"" );
+}
+#endif
+
+
+/**
+ * Run the program \a aArgv[0] with the arguments \a aArgv, and wait for it to exit.
+ *
+ * No shell is involved, so the arguments reach the child verbatim whatever characters the
+ * board paths contain.  Unlike wxExecute(), this can be called from any thread.
+ *
+ * @return the exit status of the child, or -1 if it could not be run.
+ */
+static int runProcess( const std::vector<wxString>& aArgv )
+{
+#ifdef _WIN32
+    std::vector<std::wstring>   args;
+    std::vector<const wchar_t*> argv;
+
+    for( const wxString& arg : aArgv )
+        args.push_back( quoteWindowsArg( arg ).ToStdWstring() );
+
+    for( const std::wstring& arg : args )
+        argv.push_back( arg.c_str() );
+
+    argv.push_back( nullptr );
+
+    return (int) _wspawnv( _P_WAIT, aArgv[0].wc_str(), argv.data() );
+#else
+    std::vector<std::string> args;
+    std::vector<char*>       argv;
+
+    for( const wxString& arg : aArgv )
+        args.emplace_back( arg.fn_str() );
+
+    for( std::string& arg : args )
+        argv.push_back( &arg[0] );
+
+    argv.push_back( nullptr );
+
+    pid_t pid;
+
+    if( posix_spawn( &pid, argv[0], nullptr, nullptr, argv.data(), environ ) != 0 )
+        return -1;
+
+    int status = 0;
+
+    while( waitpid( pid, &status, 0 ) < 0 )
+    {
+        if( errno != EINTR )
+            return -1;
+    }
+
+    return WIFEXITED( status ) ? WEXITSTATUS( status ) : -1;
+#endif
+}
+
+
+/**
+ * Process several boards, \a aJobs at a time.
+ *
+ * The settings manager, the projects and the plotters rely on global state, so each board is
+ * handed to a child process running this tool on a single board.  The worker threads only
+ * wait for the children and collect their reports.
+ */
+static int processBoards( const std::vector<wxString>& aBoards, const BATCH_OPTIONS& aOptions,
+                          size_t aJobs, nlohmann::json& aReport )
+{
+    wxString executable = wxStandardPaths::Get().GetExecutablePath();
+    wxString tmpDir = wxFileName::CreateTempFileName( wxT( "pcb_batch" ) );
+
+    // Reuse the unique temporary name as a directory for the child reports
+    wxRemoveFile( tmpDir );
+    wxFileName::Mkdir( tmpDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+    std::vector<nlohmann::json> reports( aBoards.size() );
+    std::vector<int>            retCodes( aBoards.size(), KI_TEST::RET_CODES::OK );
+    std::atomic<size_t>         nextBoard( 0 );
+
+    auto runChild =
+            [&]( size_t aIndex )
+            {
+                wxFileName            childReport( tmpDir, std::to_string( aIndex ), "json" );
+                std::vector<wxString> argv = { executable, wxT( "pcb_batch" ) };
+
+                if( !aOptions.m_outputDir.IsEmpty() )
+                {
+                    argv.push_back( wxT( "-o" ) );
+                    argv.push_back( aOptions.m_outputDir );
+                }
+
+                if( !aOptions.m_fillZones )
+                    argv.push_back( wxT( "--no-fill" ) );
+
+                if( !aOptions.m_runDRC )
+                    argv.push_back( wxT( "--no-drc" ) );
+
+                if( !aOptions.m_plot )
+                    argv.push_back( wxT( "--no-plot" ) );
+
+                argv.push_back( wxT( "-r" ) );
+                argv.push_back( childReport.GetFullPath() );
+
+                // Keep a board named like an option from being parsed as one
+                argv.push_back( wxT( "--" ) );
+                argv.push_back( aBoards[aIndex] );
+
+                PROF_COUNTER  timer;
+                int           status = runProcess( argv );
+                std::ifstream in( childReport.GetFullPath().fn_str() );
+
+                timer.Stop();
+
+                try
+                {
+                    in >> reports[aIndex];
+                    retCodes[aIndex] = reports[aIndex].value<int>( "result", LOAD_FAILED );
+                }
+                catch( const nlohmann::json::exception& )
+                {
+                    reports[aIndex] = { { "board", std::string( aBoards[aIndex].ToUTF8() ) },
+                                        { "error", "no report (exit status "
+                                                   + std::to_string( status ) + ")" } };
+                    retCodes[aIndex] = PCB_BATCH_RET_CODES::LOAD_FAILED;
+                }
+
+                reports[aIndex]["wall_ms"] = timer.msecs();
+            };
+
+    auto worker =
+            [&]()
+            {
+                for( size_t ii = nextBoard++; ii < aBoards.size(); ii = nextBoard++ )
+                    runChild( ii );
+            };
+
+    std::vector<std::future<void>> returns( std::min( aJobs, aBoards.size() ) );
+
+    for( std::future<void>& ret : returns )
+        ret = std::async( std::launch::async, worker );
+
+    for( const std::future<void>& ret : returns )
+        ret.wait();
+
+    wxFileName::Rmdir( tmpDir, wxPATH_RMDIR_RECURSIVE );
+
+    aReport["boards"] = reports;
+
+    return *std::max_element( retCodes.begin(), retCodes.end() );
+}
+
+
+int pcb_batch_main( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program fills the zones, runs the design rules checks and plots the "
+               "fabrication files of boards without the GUI.  Violations, the time used by "
+               "every stage and the peak memory used for each board are written as JSON.  "
+               "Directories are searched for board files." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    BATCH_OPTIONS options;
+    wxString      reportFile;
+    long          jobs = std::thread::hardware_concurrency();
+
+    cl_parser.Found( "output", &options.m_outputDir );
+    cl_parser.Found( "report", &reportFile );
+    cl_parser.Found( "jobs", &jobs );
+    options.m_fillZones = !cl_parser.Found( "no-fill" );
+    options.m_runDRC = !cl_parser.Found( "no-drc" );
+    options.m_plot = !cl_parser.Found( "no-plot" );
+
+    std::vector<wxString> boards;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+    {
+        wxString param = cl_parser.GetParam( ii );
+
+        if( wxFileName::DirExists( param ) )
+        {
+            wxArrayString files;
+            wxDir::GetAllFiles( param, &files, wxT( "*." ) + KiCadPcbFileExtension );
+
+            // Keep the report order stable between runs
+            files.Sort();
+
+            for( const wxString& file : files )
+                boards.push_back( file );
+        }
+        else
+        {
+            boards.push_back( param );
+        }
+    }
+
+    if( boards.empty() )
+    {
+        std::cerr << "No board file found" << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    nlohmann::json report;
+    int            retCode;
+
+    if( boards.size() == 1 )
+        retCode = processBoard( boards[0], options, report );
+    else
+        retCode = processBoards( boards, options, std::max( 1L, jobs ), report );
+
+    if( reportFile.IsEmpty() )
+    {
+        std::cout << std::setw( 2 ) << report << std::endl;
+    }
+    else
+    {
+        std::ofstream out( reportFile.fn_str() );
+        out << std::setw( 2 ) << report << std::endl;
+    }
+
+    return retCode;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pcb_batch",
+        "Fill zones, run DRC and plot PCBs, reporting violations and timings as JSON",
+        pcb_batch_main,
+} );
@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <profile.h>
+
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+
+/**
+ * Benchmark for SHAPE_POLY_SET::ParallelSimplify().
+ *
+ * The knockout shapes of all the pads and tracks of a board (as built by the zone filler) are
+ * merged serially and then with an increasing number of threads.  Each parallel result is
+ * checked against the serial one.
+ */
+
+enum POLY_BOOL_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RESULT_MISMATCH
+};
+
+
+static void buildKnockouts( BOARD* aBoard, PCB_LAYER_ID aLayer, int aClearance,
+                            SHAPE_POLY_SET& aKnockouts )
+{
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( track->IsOnLayer( aLayer ) )
+        {
+            track->TransformShapeWithClearanceToPolygon( aKnockouts, aLayer, aClearance,
+                                                         ARC_HIGH_DEF, ERROR_OUTSIDE );
+        }
+    }
+
+    for( FOOTPRINT* fp : aBoard->Footprints() )
+    {
+        for( PAD* pad : fp->Pads() )
+        {
+            if( pad->IsOnLayer( aLayer ) )
+            {
+                pad->TransformShapeWithClearanceToPolygon( aKnockouts, aLayer, aClearance,
+                                                           ARC_HIGH_DEF, ERROR_OUTSIDE );
+            }
+        }
+    }
+}
+
+
+int polygon_boolean_main( int argc, char* argv[] )
+{
+    std::string filename;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return POLY_BOOL_RET_CODES::LOAD_FAILED;
+
+    const int clearance = brd->GetDesignSettings().m_MinClearance;
+    SHAPE_POLY_SET knockouts;
+
+    for( PCB_LAYER_ID layer : LSET::AllCuMask().Seq() )
+        buildKnockouts( brd.get(), layer, clearance, knockouts );
+
+    printf( "%d polygons, %d vertices\n", knockouts.OutlineCount(), knockouts.TotalVertices() );
+
+    SHAPE_POLY_SET serial = knockouts;
+    PROF_COUNTER   serialCnt( "serial" );
+
+    serial.Simplify( SHAPE_POLY_SET::PM_FAST );
+    serialCnt.Stop();
+
+    const double serialMs = serialCnt.msecs();
+    const double serialArea = serial.Area();
+
+    printf( "threads  time (ms)  speedup  area delta\n" );
+    printf( "%7d  %9.1f  %7.2f  %10.0f\n", 0, serialMs, 1.0, 0.0 );
+
+    size_t maxThreads = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+    int    retCode = KI_TEST::RET_CODES::OK;
+
+    for( size_t threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+        SHAPE_POLY_SET parallel = knockouts;
+        PROF_COUNTER   parallelCnt;
+
+        parallel.ParallelSimplify( SHAPE_POLY_SET::PM_FAST, threads );
+        parallelCnt.Stop();
+
+        const double delta = std::abs( parallel.Area() - serialArea );
+
+        printf( "%7zu  %9.1f  %7.2f  %10.0f\n", threads, parallelCnt.msecs(),
+                serialMs / parallelCnt.msecs(), delta );
+
+        // Only rounding of the intersection points is allowed to differ
+        if( delta > serialArea * 1e-6 )
+            retCode = POLY_BOOL_RET_CODES::RESULT_MISMATCH;
+    }
+
+    return retCode;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "polygon_boolean",
+        "Benchmark the parallel polygon boolean engine on the copper of a PCB",
+        polygon_boolean_main,
+} );
@@ -0,0 +1,134 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_marker.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <pcb_painter.h>
+#include <pcb_view.h>
+#include <profile.h>
+
+#include <gal/graphics_abstraction_layer.h>
+
+
+enum VIEW_RECACHE_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * Measure the time needed to build and rebuild the view cache of a board.
+ *
+ * The base GAL has no window and ignores all drawing calls, so this measures the CPU side of
+ * the recache, not the tessellation into the GAL vertex buffers nor the upload to the GPU.
+ * Three passes are timed separately:
+ *  - the initial cache, where the items' geometry is prepared (in parallel) and painted;
+ *  - RecacheAllItems() with the items' own geometry caches still valid, which only measures
+ *    the serial painting;
+ *  - RecacheAllItems() after invalidating the pads' shapes, where the parallel preparation
+ *    has real work to do again.
+ */
+int view_recache_main( int argc, char *argv[] )
+{
+    std::string filename;
+    int         iterations = 5;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    if( argc > 2 )
+        iterations = std::max( 1, atoi( argv[2] ) );
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return VIEW_RECACHE_RET_CODES::LOAD_FAILED;
+
+    KIGFX::GAL_DISPLAY_OPTIONS options;
+    KIGFX::GAL                 gal( options );
+    KIGFX::PCB_PAINTER         painter( &gal );
+    KIGFX::PCB_VIEW            view;
+
+    view.SetGAL( &gal );
+    view.SetPainter( &painter );
+
+    for( BOARD_ITEM* drawing : brd->Drawings() )
+        view.Add( drawing );
+
+    for( PCB_TRACK* track : brd->Tracks() )
+        view.Add( track );
+
+    for( FOOTPRINT* footprint : brd->Footprints() )
+        view.Add( footprint );
+
+    for( PCB_MARKER* marker : brd->Markers() )
+        view.Add( marker );
+
+    for( ZONE* zone : brd->Zones() )
+        view.Add( zone );
+
+    PROF_COUNTER initial( "initial cache" );
+    view.UpdateItems();
+    initial.Show();
+
+    for( int ii = 0; ii < iterations; ++ii )
+    {
+        PROF_COUNTER recache( "recache, item geometry cached" );
+        view.RecacheAllItems();
+        view.UpdateItems();
+        recache.Show();
+    }
+
+    for( int ii = 0; ii < iterations; ++ii )
+    {
+        for( FOOTPRINT* footprint : brd->Footprints() )
+        {
+            for( PAD* pad : footprint->Pads() )
+                pad->SetDirty();
+        }
+
+        PROF_COUNTER recache( "recache, pad shapes rebuilt" );
+        view.RecacheAllItems();
+        view.UpdateItems();
+        recache.Show();
+    }
+
+    view.Clear();
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "view_recache",
+        "Measure the time to rebuild the view cache of a PCB",
+        view_recache_main,
+} );
@@ -148,6 +148,13 @@ public:
                  const ELEMTYPE     a_max[NUMDIMS],
                  const DATATYPE&    a_dataId );
 
+    /// Replace the contents of the tree with the given entries
+    /// The nodes are packed with the Sort-Tile-Recursive algorithm, which is much faster than
+    /// inserting the entries one by one and gives full nodes with little overlap.  The tree
+    /// can be modified with Insert() and Remove() afterwards.
+    /// \param a_entries Bounding rects and data of the entries.
+    void BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries );
+
     /// Remove entry
     /// \param a_min Min of bounding rect
     /// \param a_max Max of bounding rect
@@ -550,6 +557,8 @@ protected:
     void            PickSeeds( PartitionVars* a_parVars ) const;
     void            Classify( int a_index, int a_group, PartitionVars* a_parVars ) const;
     bool            RemoveRect( const Rect* a_rect, const DATATYPE& a_id, Node** a_root ) const;
+    void            SortTileRecursive( Branch* a_begin, Branch* a_end, int a_axis, size_t a_offset,
+                                       std::vector<size_t>& a_nodeEnds ) const;
     bool            RemoveRectRec( const Rect*      a_rect,
                                    const DATATYPE&  a_id,
                                    Node*            a_node,
@@ -755,6 +764,101 @@ void RTREE_QUAL::Insert( const ELEMTYPE     a_min[NUMDIMS],
 }
 
 
+RTREE_TEMPLATE
+void RTREE_QUAL::BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries )
+{
+    RemoveAll();
+
+    std::vector<Branch> branches( a_entries.size() );
+
+    for( size_t index = 0; index < a_entries.size(); ++index )
+    {
+        branches[index].m_rect = a_entries[index].first;
+        branches[index].m_data = a_entries[index].second;
+    }
+
+    int level = 0;
+
+    // Pack each level in nodes, until the remaining branches fit in the root
+    while( branches.size() > MAXNODES )
+    {
+        // The tiling gives the node boundaries, so that no node straddles two slabs
+        std::vector<size_t> nodeEnds;
+
+        SortTileRecursive( branches.data(), branches.data() + branches.size(), 0, 0, nodeEnds );
+
+        size_t first = 0;
+
+        std::vector<Branch> parents( nodeEnds.size() );
+
+        for( size_t nodeIndex = 0; nodeIndex < nodeEnds.size(); ++nodeIndex )
+        {
+            size_t last = nodeEnds[nodeIndex];
+            Node*  node = AllocNode();
+
+            node->m_level = level;
+            node->m_count = (int) ( last - first );
+            std::copy( branches.begin() + first, branches.begin() + last, node->m_branch );
+
+            parents[nodeIndex].m_rect = NodeCover( node );
+            parents[nodeIndex].m_child = node;
+            first = last;
+        }
+
+        branches.swap( parents );
+        ++level;
+    }
+
+    m_root->m_level = level;
+    m_root->m_count = (int) branches.size();
+    std::copy( branches.begin(), branches.end(), m_root->m_branch );
+}
+
+
+RTREE_TEMPLATE
+void RTREE_QUAL::SortTileRecursive( Branch* a_begin, Branch* a_end, int a_axis, size_t a_offset,
+                                    std::vector<size_t>& a_nodeEnds ) const
+{
+    auto center =
+            [a_axis]( const Branch& a_branch )
+            {
+                return (double) a_branch.m_rect.m_min[a_axis]
+                       + (double) a_branch.m_rect.m_max[a_axis];
+            };
+
+    std::sort( a_begin, a_end,
+               [&]( const Branch& a_left, const Branch& a_right )
+               {
+                   return center( a_left ) < center( a_right );
+               } );
+
+    size_t count = a_end - a_begin;
+    size_t nodeCount = ( count + MAXNODES - 1 ) / MAXNODES;
+
+    if( a_axis == NUMDIMS - 1 )
+    {
+        // Cut the last axis in nodes.  The slabs above hold a multiple of MAXNODES branches,
+        // except for the last one whose branches are spread evenly over its nodes.
+        for( size_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex )
+            a_nodeEnds.push_back( a_offset + count * ( nodeIndex + 1 ) / nodeCount );
+
+        return;
+    }
+
+    // Cut the branches in slabs along this axis, then tile each slab along the next axes
+    size_t slabCount = (size_t) std::ceil( std::pow( (double) nodeCount,
+                                                     1.0 / ( NUMDIMS - a_axis ) ) );
+    size_t slabSize = MAXNODES * ( ( nodeCount + slabCount - 1 ) / slabCount );
+
+    for( size_t first = 0; first < count; first += slabSize )
+    {
+        size_t last = std::min( first + slabSize, count );
+        SortTileRecursive( a_begin + first, a_begin + last, a_axis + 1, a_offset + first,
+                           a_nodeEnds );
+    }
+}
+
+
 RTREE_TEMPLATE
 bool RTREE_QUAL::Remove( const ELEMTYPE     a_min[NUMDIMS],
                          const ELEMTYPE     a_max[NUMDIMS],
@@ -84,7 +84,7 @@ KICAD2MCAD_PRMS::KICAD2MCAD_PRMS()
     m_xOrigin = 0.0;
     m_yOrigin = 0.0;
     m_minDistance = MIN_DISTANCE;
-
+    m_useModelCache = true;
 }
 
 
@@ -120,6 +120,9 @@ static const wxCmdLineEntryDesc cmdLineDesc[] =
         { wxCMD_LINE_SWITCH, NULL, "subst-models",
             _( "Substitute STEP or IGS models with the same name in place of VRML models" ).mb_str(),
             wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
+        { wxCMD_LINE_SWITCH, NULL, "no-model-cache",
+            _( "Do not read nor write the cache of translated 3D models" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
         { wxCMD_LINE_OPTION, NULL, "min-distance",
             _( "Minimum distance between points to treat them as separate ones (default 0.01 mm)" ).mb_str(),
             wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
@@ -216,6 +219,9 @@ bool KICAD2MCAD_APP::OnCmdLineParsed( wxCmdLineParser& parser )
     if( parser.Found( "subst-models" ) )
         m_params.m_substModels = true;
 
+    if( parser.Found( "no-model-cache" ) )
+        m_params.m_useModelCache = false;
+
     wxString tstr;
 
     if( parser.Found( "user-origin", &tstr ) )
@@ -376,6 +382,7 @@ int PANEL_KICAD2STEP::RunConverter()
 
     pcb.SetOrigin( m_params.m_xOrigin, m_params.m_yOrigin );
     pcb.SetMinDistance( m_params.m_minDistance );
+    pcb.UseModelCache( m_params.m_useModelCache );
     ReportMessage( wxString::Format( "Read: %s\n", m_params.m_filename ) );
 
     // create the new streams to "redirect" cout and cerr output to
@@ -50,6 +50,7 @@ public:
     bool     m_useDrillOrigin;
     bool     m_includeVirtual;
     bool     m_substModels;
+    bool     m_useModelCache;
     wxString m_filename;
     wxString m_outputFile;
     double   m_xOrigin;
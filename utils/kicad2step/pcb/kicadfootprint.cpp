@@ -41,6 +41,13 @@
 #include <Standard_Failure.hxx>
 
 
+static std::string resolveModelPath( S3D_RESOLVER* aResolver, const KICADMODEL* aModel )
+{
+    return std::string( aResolver->ResolvePath(
+            wxString::FromUTF8Unchecked( aModel->m_modelname.c_str() ) ).ToUTF8() );
+}
+
+
 KICADFOOTPRINT::KICADFOOTPRINT( KICADPCB* aParent )
 {
     m_parent = aParent;
@@ -417,8 +424,7 @@ bool KICADFOOTPRINT::ComposePCB( class PCBMODEL* aPCB, S3D_RESOLVER* resolver,
 
     for( auto i : m_models )
     {
-        std::string fname( resolver->ResolvePath(
-            wxString::FromUTF8Unchecked( i->m_modelname.c_str() ) ).ToUTF8() );
+        std::string fname( resolveModelPath( resolver, i ) );
 
         try
         {
@@ -436,3 +442,14 @@ bool KICADFOOTPRINT::ComposePCB( class PCBMODEL* aPCB, S3D_RESOLVER* resolver,
 
     return hasdata;
 }
+
+
+void KICADFOOTPRINT::GetModelFileNames( S3D_RESOLVER* resolver, bool aComposeVirtual,
+                                        std::vector<std::string>& aFileNames ) const
+{
+    if( m_virtual && !aComposeVirtual )
+        return;
+
+    for( auto i : m_models )
+        aFileNames.push_back( resolveModelPath( resolver, i ) );
+}
@@ -73,6 +73,10 @@ public:
 
     bool ComposePCB( class PCBMODEL* aPCB, S3D_RESOLVER* resolver,
         DOUBLET aOrigin, bool aComposeVirtual = true, bool aSubstituteModels = true );
+
+    // append the resolved file names of the models ComposePCB() would add
+    void GetModelFileNames( S3D_RESOLVER* resolver, bool aComposeVirtual,
+                            std::vector<std::string>& aFileNames ) const;
 };
 
 #endif  // KICADFOOTPRINT_H
@@ -48,6 +48,7 @@ KICADPCB::KICADPCB()
     m_thickness = 1.6;
     m_pcb_model = nullptr;
     m_minDistance = MIN_DISTANCE;
+    m_useModelCache = true;
     m_useGridOrigin = false;
     m_useDrillOrigin = false;
     m_hasGridOrigin = false;
@@ -481,6 +482,9 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual, bool aSubstituteModels )
     m_pcb_model->SetPCBThickness( m_thickness );
     m_pcb_model->SetMinDistance( m_minDistance );
 
+    if( !m_useModelCache )
+        m_pcb_model->SetModelCacheDir( wxEmptyString );
+
     for( auto i : m_curves )
     {
         if( CURVE_NONE == i->m_form || LAYER_EDGE != i->m_layer )
@@ -506,6 +510,14 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual, bool aSubstituteModels )
         m_pcb_model->AddOutlineSegment( &lcurve );
     }
 
+    // Read every distinct model once, before instancing them for each footprint
+    std::vector<std::string> modelFiles;
+
+    for( auto i : m_footprints )
+        i->GetModelFileNames( &m_resolver, aComposeVirtual, modelFiles );
+
+    m_pcb_model->PreloadModels( modelFiles, aSubstituteModels );
+
     for( auto i : m_footprints )
         i->ComposePCB( m_pcb_model, &m_resolver, origin, aComposeVirtual, aSubstituteModels );
 
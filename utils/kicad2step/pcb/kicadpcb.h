@@ -66,6 +66,8 @@ private:
     bool        m_hasDrillOrigin;
     // minimum distance between points to treat them as separate entities (mm)
     double      m_minDistance;
+    // set to false to neither read nor write the translated model cache
+    bool        m_useModelCache;
     // the names of layers in use, and the internal layer ID
     std::map<std::string, int> m_layersNames;
 
@@ -111,6 +113,11 @@ public:
         m_minDistance = aDistance;
     }
 
+    void UseModelCache( bool aUseCache )
+    {
+        m_useModelCache = aUseCache;
+    }
+
     bool ReadFile( const wxString& aFileName );
     bool ComposePCB( bool aComposeVirtual = true, bool aSubstituteModels = true );
     bool WriteSTEP( const wxString& aFileName );
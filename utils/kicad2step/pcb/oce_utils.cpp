@@ -23,10 +23,15 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <future>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
+#include <wx/dir.h>
 #include <wx/filename.h>
 #include <wx/filefn.h>
 #include <wx/stdpaths.h>
@@ -46,6 +51,7 @@
 #include <IGESData_IGESModel.hxx>
 #include <Interface_Static.hxx>
 #include <Quantity_Color.hxx>
+#include <STEPCAFControl_Controller.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <STEPCAFControl_Writer.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
@@ -67,7 +73,14 @@
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepPrimAPI_MakePrism.hxx>
 #include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepAlgoAPI_Common.hxx>
 #include <BRepAlgoAPI_Cut.hxx>
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Bnd_Box.hxx>
+#include <ShapeUpgrade_UnifySameDomain.hxx>
+#include <TopTools_ListOfShape.hxx>
 
 #include <TopoDS.hxx>
 #include <TopoDS_Wire.hxx>
@@ -83,6 +96,29 @@
 #include <gp_Pnt.hxx>
 #include <Geom_BezierCurve.hxx>
 
+#include <kiplatform/environment.h>
+
+// The STEP translator can be used from several threads at once since OpenCascade 7.5
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070500 )
+#define PARALLEL_STEP_READ
+#endif
+
+// The binary XCAF format used by the translated model cache can be registered since
+// OpenCascade 7.2
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070200 )
+#define STEP_MODEL_CACHE
+#include <BinXCAFDrivers.hxx>
+#endif
+
+// Boolean operations can run in parallel and leave their arguments untouched since
+// OpenCascade 7.2, which allows to cut the board tile by tile
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070200 )
+#define TILED_BOARD_CUT
+#endif
+
+// size above which the least recently used entries of the translated model cache are removed
+static constexpr unsigned long long MODEL_CACHE_MAX_SIZE = 512ULL * 1024 * 1024;
+
 static constexpr double USER_PREC = 1e-4;
 static constexpr double USER_ANGLE_PREC = 1e-6;
 // minimum PCB thickness in mm (2 microns assumes a very thin polyimide film)
@@ -93,6 +129,12 @@ static constexpr double THICKNESS_DEFAULT = 1.6;
 static constexpr double BOARD_OFFSET = 0.05;
 // min. length**2 below which 2 points are considered coincident
 static constexpr double MIN_LENGTH2 = MIN_DISTANCE * MIN_DISTANCE;
+// boards with fewer holes than this are cut with a single boolean operation
+static constexpr size_t TILED_CUT_MIN_HOLES = 1000;
+// approximate number of holes cut in each tile of the board
+static constexpr size_t TILE_HOLE_COUNT = 250;
+// distance (mm) by which the outer tiles extend past the board
+static constexpr double TILE_MARGIN = 1.0;
 
 static void getEndPoints( const KICADCURVE& aCurve, double& spx0, double& spy0,
     double& epx0, double& epy0 )
@@ -237,6 +279,183 @@ FormatType fileType( const char* aFileName )
 }
 
 
+/**
+ * Return the STEP and IGES files which may replace a VRML model, in order of preference.
+ */
+static std::vector<std::string> substituteModels( const std::string& aFileName )
+{
+    std::vector<std::string> substitutes;
+    wxFileName wrlName( aFileName );
+
+    wxString basePath = wrlName.GetPath();
+    wxString baseName = wrlName.GetName();
+
+    // List of alternate files to look for
+    // Given in order of preference
+    wxArrayString alts;
+
+    // Step files
+    alts.Add( "stp" );
+    alts.Add( "step" );
+    alts.Add( "STP" );
+    alts.Add( "STEP" );
+    alts.Add( "Stp" );
+    alts.Add( "Step" );
+    alts.Add( "stpz" );
+    alts.Add( "stpZ" );
+    alts.Add( "STPZ" );
+    alts.Add( "step.gz" );
+
+    // IGES files
+    alts.Add( "iges" );
+    alts.Add( "IGES" );
+    alts.Add( "igs" );
+    alts.Add( "IGS" );
+
+    //TODO - Other alternative formats?
+
+    for( const auto& alt : alts )
+    {
+        wxFileName altFile( basePath, baseName + "." + alt );
+
+        if( altFile.IsOk() && altFile.FileExists() )
+            substitutes.push_back( altFile.GetFullPath().ToStdString() );
+    }
+
+    return substitutes;
+}
+
+
+/**
+ * Decompress a gzip or zip compressed STEP file into a new temporary file.
+ */
+static bool decompressModel( const std::string& aFileName, wxString& aStepFile )
+{
+    wxFFileInputStream ifile( aFileName );
+    wxFileOffset       size = ifile.GetLength();
+
+    if( size == wxInvalidOffset )
+        return false;
+
+    aStepFile = wxFileName::CreateTempFileName( "kicad2step" );
+
+    if( aStepFile.IsEmpty() )
+        return false;
+
+    bool                success = false;
+    wxFFileOutputStream ofile( aStepFile );
+
+    if( !ofile.IsOk() )
+        return false;
+
+    std::vector<char> buffer( size );
+    std::string       expanded;
+
+    ifile.Read( buffer.data(), size );
+
+    try
+    {
+        expanded = gzip::decompress( buffer.data(), size );
+    }
+    catch(...)
+    {}
+
+    if( expanded.empty() )
+    {
+        ifile.Reset();
+        ifile.SeekI( 0 );
+        wxZipInputStream izipfile( ifile );
+        std::unique_ptr<wxZipEntry> zip_file( izipfile.GetNextEntry() );
+
+        if( zip_file && !zip_file->IsDir() && izipfile.CanRead() )
+        {
+            izipfile.Read( ofile );
+            success = true;
+        }
+    }
+    else
+    {
+        ofile.Write( expanded.data(), expanded.size() );
+        success = true;
+    }
+
+    ofile.Close();
+
+    return success;
+}
+
+
+/**
+ * Return a hash (64 bit FNV-1a) of the contents of a model file, which is the key of the
+ * translated model cache, or an empty string if the file cannot be read.
+ */
+static std::string modelHash( const std::string& aFileName )
+{
+    OPEN_ISTREAM( ifile, aFileName.c_str() );
+
+    if( ifile.fail() )
+        return std::string();
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    char     buffer[65536];
+
+    while( ifile )
+    {
+        ifile.read( buffer, sizeof( buffer ) );
+
+        for( std::streamsize ii = 0; ii < ifile.gcount(); ++ii )
+        {
+            hash ^= static_cast<unsigned char>( buffer[ii] );
+            hash *= 0x100000001b3ULL;
+        }
+    }
+
+    CLOSE_STREAM( ifile );
+
+    // The suffix changes whenever the translation parameters do
+    char key[32];
+    snprintf( key, sizeof( key ), "%016llx_1", static_cast<unsigned long long>( hash ) );
+
+    return key;
+}
+
+
+static bool setReadPrecision()
+{
+    // Enable user-defined shape precision
+    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+        return false;
+
+    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
+    return Interface_Static::SetRVal( "read.precision.val", USER_PREC );
+}
+
+
+/**
+ * Read a STEP file into \a aDoc.  The read precision must have been set beforehand.
+ *
+ * Only objects local to the call are used, so several files can be read at once.
+ */
+static bool readSTEPFile( Handle( TDocStd_Document )& aDoc, const char* aFileName )
+{
+    STEPCAFControl_Reader reader;
+
+    if( reader.ReadFile( aFileName ) != IFSelect_RetDone )
+        return false;
+
+    // set other translation options
+    reader.SetColorMode(true);  // use model colors
+    reader.SetNameMode(false);  // don't use label names
+    reader.SetLayerMode(false); // ignore LAYER data
+
+    if( !reader.Transfer( aDoc ) )
+        return false;
+
+    // are there any shapes to translate?
+    return reader.NbRootsForTransfer() >= 1;
+}
+
+
 PCBMODEL::PCBMODEL()
 {
     m_app = XCAFApp_Application::GetApplication();
@@ -252,12 +471,35 @@ PCBMODEL::PCBMODEL()
     m_minx = 1.0e10;    // absurdly large number; any valid PCB X value will be smaller
     m_mincurve = m_curves.end();
     BRepBuilderAPI::Precision( MIN_DISTANCE );
+
+#ifdef STEP_MODEL_CACHE
+    static bool binaryFormatDefined = false;
+
+    if( !binaryFormatDefined )
+    {
+        BinXCAFDrivers::DefineFormat( m_app );
+        binaryFormatDefined = true;
+    }
+
+    wxFileName cacheDir;
+    cacheDir.AssignDir( KIPLATFORM::ENV::GetUserCachePath() );
+    cacheDir.AppendDir( "kicad" );
+    cacheDir.AppendDir( "kicad2step" );
+    m_cacheDir = cacheDir.GetPath();
+#endif
+
     return;
 }
 
 
 PCBMODEL::~PCBMODEL()
 {
+    for( MODEL_DOC_MAP::value_type& modelDoc : m_modelDocs )
+    {
+        if( !modelDoc.second.IsNull() )
+            modelDoc.second->Close();
+    }
+
     m_doc->Close();
     return;
 }
@@ -468,6 +710,13 @@ bool PCBMODEL::AddPadHole( const KICADPAD* aPad )
 
     if( !aPad->m_drill.oval )
     {
+        // Stacked pads and pads shared by several footprints only need to be cut once
+        if( !m_roundHoles.emplace( aPad->m_position.x, aPad->m_position.y,
+                                   aPad->m_drill.size.x ).second )
+        {
+            return true;
+        }
+
         TopoDS_Shape s = BRepPrimAPI_MakeCylinder( aPad->m_drill.size.x * 0.5,
             m_thickness * 2.0 ).Shape();
         gp_Trsf shift;
@@ -836,23 +1085,9 @@ bool PCBMODEL::CreatePCB()
             ReportMessage( wxString::Format( ". %d/%d\n", cur_count, cntmax ) );
         }
     }
-#else   // Much faster than first version: group all holes and cut only once
-    if( m_cutouts.size() )
-    {
-        BRepAlgoAPI_Cut Cut;
-        TopTools_ListOfShape mainbrd;
-        mainbrd.Append( board );
-
-        Cut.SetArguments( mainbrd );
-        TopTools_ListOfShape holelist;
-
-        for( auto hole : m_cutouts )
-             holelist.Append( hole );
-
-        Cut.SetTools( holelist );
-        Cut.Build();
-        board = Cut.Shape();
-    }
+#else   // Much faster than first version: group holes and cut them together
+    if( m_cutouts.size() && !cutBoardHoles( board ) )
+        ReportMessage( "Could not cut the board holes.\n" );
 #endif
 
     // push the board to the data structure
@@ -884,6 +1119,205 @@ bool PCBMODEL::CreatePCB()
 }
 
 
+// apply a boolean operation between aShape and aTools, leaving both untouched
+static bool booleanOperation( BRepAlgoAPI_BooleanOperation& aOperation, const TopoDS_Shape& aShape,
+                              const TopTools_ListOfShape& aTools, TopoDS_Shape& aResult )
+{
+    TopTools_ListOfShape arguments;
+    arguments.Append( aShape );
+
+    aOperation.SetArguments( arguments );
+    aOperation.SetTools( aTools );
+#ifdef TILED_BOARD_CUT
+    aOperation.SetRunParallel( Standard_True );
+    aOperation.SetNonDestructive( Standard_True );
+#endif
+    aOperation.Build();
+
+    if( !aOperation.IsDone() )
+        return false;
+
+    aResult = aOperation.Shape();
+    return true;
+}
+
+
+static bool hasSolid( const TopoDS_Shape& aShape )
+{
+    return !aShape.IsNull() && TopExp_Explorer( aShape, TopAbs_SOLID ).More();
+}
+
+
+bool PCBMODEL::cutBoardHoles( TopoDS_Shape& aBoard )
+{
+    TopTools_ListOfShape holes;
+
+    for( const TopoDS_Shape& hole : m_cutouts )
+        holes.Append( hole );
+
+#ifdef TILED_BOARD_CUT
+    if( m_cutouts.size() >= TILED_CUT_MIN_HOLES )
+    {
+        struct TILE
+        {
+            Bnd_Box              m_box;
+            TopTools_ListOfShape m_holes;
+            TopoDS_Shape         m_shape;     // the part of the board in the tile, once cut
+            bool                 m_ok = false;
+        };
+
+        Bnd_Box boardBox;
+        BRepBndLib::Add( aBoard, boardBox );
+
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        boardBox.Get( xmin, ymin, zmin, xmax, ymax, zmax );
+
+        // Lay the tiles out so that they are roughly square
+        double width = xmax - xmin;
+        double height = std::max( ymax - ymin, m_precision );
+        double tileCount = std::ceil( (double) m_cutouts.size() / TILE_HOLE_COUNT );
+        int    cols = std::max( 1, (int) std::lround( std::sqrt( tileCount * width / height ) ) );
+        int    rows = std::max( 1, (int) std::ceil( tileCount / cols ) );
+
+        std::vector<TILE> tiles( rows * cols );
+
+        // The outer tiles extend past the board so that none of their faces lies on a board face
+        for( int row = 0; row < rows; ++row )
+        {
+            double y0 = row == 0 ? ymin - TILE_MARGIN : ymin + height * row / rows;
+            double y1 = row == rows - 1 ? ymax + TILE_MARGIN : ymin + height * ( row + 1 ) / rows;
+
+            for( int col = 0; col < cols; ++col )
+            {
+                double x0 = col == 0 ? xmin - TILE_MARGIN : xmin + width * col / cols;
+                double x1 = col == cols - 1 ? xmax + TILE_MARGIN
+                                            : xmin + width * ( col + 1 ) / cols;
+
+                tiles[row * cols + col].m_box.Update( x0, y0, zmin - TILE_MARGIN,
+                                                      x1, y1, zmax + TILE_MARGIN );
+            }
+        }
+
+        // Holes crossing a tile border are cut in every tile they touch
+        for( const TopoDS_Shape& hole : m_cutouts )
+        {
+            Bnd_Box holeBox;
+            BRepBndLib::Add( hole, holeBox );
+
+            for( TILE& tile : tiles )
+            {
+                if( !tile.m_box.IsOut( holeBox ) )
+                    tile.m_holes.Append( hole );
+            }
+        }
+
+        ReportMessage( wxString::Format( "Cut board holes in %d tiles.\n", rows * cols ) );
+
+        std::atomic<size_t> nextTile( 0 );
+
+        auto cut_lambda =
+                [&]()
+                {
+                    for( size_t ii = nextTile++; ii < tiles.size(); ii = nextTile++ )
+                    {
+                        TILE& tile = tiles[ii];
+
+                        try
+                        {
+                            double x0, y0, z0, x1, y1, z1;
+                            tile.m_box.Get( x0, y0, z0, x1, y1, z1 );
+
+                            TopTools_ListOfShape box;
+                            box.Append( BRepPrimAPI_MakeBox( gp_Pnt( x0, y0, z0 ),
+                                                             gp_Pnt( x1, y1, z1 ) ).Shape() );
+
+                            BRepAlgoAPI_Common common;
+                            tile.m_ok = booleanOperation( common, aBoard, box, tile.m_shape );
+
+                            if( tile.m_ok && !tile.m_holes.IsEmpty() && hasSolid( tile.m_shape ) )
+                            {
+                                BRepAlgoAPI_Cut cut;
+                                tile.m_ok = booleanOperation( cut, tile.m_shape, tile.m_holes,
+                                                              tile.m_shape );
+                            }
+                        }
+                        catch( const Standard_Failure& )
+                        {
+                            tile.m_ok = false;
+                        }
+                    }
+                };
+
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                       tiles.size() );
+
+        if( parallelThreadCount <= 1 )
+        {
+            cut_lambda();
+        }
+        else
+        {
+            std::vector<std::future<void>> returns( parallelThreadCount );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, cut_lambda );
+
+            for( const std::future<void>& ret : returns )
+                ret.wait();
+        }
+
+        bool                 ok = true;
+        TopTools_ListOfShape pieces;
+
+        for( const TILE& tile : tiles )
+        {
+            ok &= tile.m_ok;
+
+            if( tile.m_ok && hasSolid( tile.m_shape ) )
+                pieces.Append( tile.m_shape );
+        }
+
+        if( ok && !pieces.IsEmpty() )
+        {
+            try
+            {
+                TopoDS_Shape first = pieces.First();
+                TopoDS_Shape fused = first;
+                pieces.RemoveFirst();
+
+                BRepAlgoAPI_Fuse fuse;
+
+                if( pieces.IsEmpty() || booleanOperation( fuse, first, pieces, fused ) )
+                {
+                    // Merge the faces and edges split at the tile borders
+                    ShapeUpgrade_UnifySameDomain unify( fused, Standard_True, Standard_True,
+                                                        Standard_False );
+                    unify.Build();
+                    aBoard = unify.Shape();
+                    return true;
+                }
+            }
+            catch( const Standard_Failure& )
+            {
+            }
+        }
+
+        ReportMessage( "Could not cut the board tile by tile, cutting it as a whole.\n" );
+    }
+#endif
+
+    try
+    {
+        BRepAlgoAPI_Cut cut;
+        return booleanOperation( cut, aBoard, holes, aBoard );
+    }
+    catch( const Standard_Failure& )
+    {
+        return false;
+    }
+}
+
+
 #ifdef SUPPORTS_IGES
 // write the assembly model in IGES format
 bool PCBMODEL::WriteIGES( const wxString& aFileName )
@@ -998,94 +1432,14 @@ bool PCBMODEL::getModelLabel( const std::string& aFileName, TRIPLET aScale, TDF_
 
     aLabel.Nullify();
 
-    Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
-
     FormatType modelFmt = fileType( aFileName.c_str() );
 
     switch( modelFmt )
     {
         case FMT_IGES:
-            if( !readIGES( doc, aFileName.c_str() ) )
-            {
-                ReportMessage( wxString::Format( "readIGES() failed on filename '%s'.\n",
-                               aFileName ) );
-                return false;
-            }
-            break;
-
         case FMT_STEP:
-            if( !readSTEP( doc, aFileName.c_str() ) )
-            {
-                ReportMessage( wxString::Format( "readSTEP() failed on filename '%s'.\n",
-                               aFileName ) );
-                return false;
-            }
-            break;
-
         case FMT_STEPZ:
-        {
-            wxFFileInputStream ifile( aFileName );
-            wxFileName outFile( aFileName );
-
-            outFile.SetPath( wxStandardPaths::Get().GetTempDir() );
-            outFile.SetExt( "STEP" );
-
-            wxFileOffset size = ifile.GetLength();
-
-            if( size == wxInvalidOffset )
-            {
-                ReportMessage( wxString::Format( "readSTEP() failed on filename '%s'.\n",
-                                                 aFileName ) );
-                return false;
-            }
-
-            {
-                bool success = false;
-                wxFFileOutputStream ofile( outFile.GetFullPath() );
-
-                if( !ofile.IsOk() )
-                    return false;
-
-                char *buffer = new char[size];
-
-                ifile.Read( buffer, size);
-                std::string expanded;
-
-                try
-                {
-                    expanded = gzip::decompress( buffer, size );
-                    success = true;
-                }
-                catch(...)
-                {}
-
-                if( expanded.empty() )
-                {
-                    ifile.Reset();
-                    ifile.SeekI( 0 );
-                    wxZipInputStream izipfile( ifile );
-                    std::unique_ptr<wxZipEntry> zip_file( izipfile.GetNextEntry() );
-
-                    if( zip_file && !zip_file->IsDir() && izipfile.CanRead() )
-                    {
-                        izipfile.Read( ofile );
-                        success = true;
-                    }
-                }
-                else
-                {
-                    ofile.Write( expanded.data(), expanded.size() );
-                }
-
-                delete[] buffer;
-                ofile.Close();
-
-                return success;
-            }
-
             break;
-        }
 
         case FMT_WRL:
         case FMT_WRZ:
@@ -1102,55 +1456,18 @@ bool PCBMODEL::getModelLabel( const std::string& aFileName, TRIPLET aScale, TDF_
              */
             if( aSubstituteModels )
             {
-                wxFileName wrlName( aFileName );
-
-                wxString basePath = wrlName.GetPath();
-                wxString baseName = wrlName.GetName();
-
-                // List of alternate files to look for
-                // Given in order of preference
-                // (Break if match is found)
-                wxArrayString alts;
-
-                // Step files
-                alts.Add( "stp" );
-                alts.Add( "step" );
-                alts.Add( "STP" );
-                alts.Add( "STEP" );
-                alts.Add( "Stp" );
-                alts.Add( "Step" );
-                alts.Add( "stpz" );
-                alts.Add( "stpZ" );
-                alts.Add( "STPZ" );
-                alts.Add( "step.gz" );
-
-                // IGES files
-                alts.Add( "iges" );
-                alts.Add( "IGES" );
-                alts.Add( "igs" );
-                alts.Add( "IGS" );
-
-                //TODO - Other alternative formats?
-
-                for( const auto& alt : alts )
+                for( const std::string& altFileName : substituteModels( aFileName ) )
                 {
-                    wxFileName altFile( basePath, baseName + "." + alt );
-
-                    if( altFile.IsOk() && altFile.FileExists() )
+                    // When substituting a STEP/IGS file for VRML, do not apply the VRML scaling
+                    // to the new STEP model.  This process of auto-substitution is janky as all
+                    // heck so let's not mix up un-displayed scale factors with potentially
+                    // mis-matched files.  And hope that the user doesn't have multiples files
+                    // named "model.wrl" and "model.stp" referring to different parts.
+                    // TODO: Fix model handling in v7.  Default models should only be STP.
+                    //       Have option to override this in DISPLAY.
+                    if( getModelLabel( altFileName, TRIPLET( 1.0, 1.0, 1.0 ), aLabel, false ) )
                     {
-                        std::string altFileName = altFile.GetFullPath().ToStdString();
-
-                        // When substituting a STEP/IGS file for VRML, do not apply the VRML scaling
-                        // to the new STEP model.  This process of auto-substitution is janky as all
-                        // heck so let's not mix up un-displayed scale factors with potentially
-                        // mis-matched files.  And hope that the user doesn't have multiples files
-                        // named "model.wrl" and "model.stp" referring to different parts.
-                        // TODO: Fix model handling in v7.  Default models should only be STP.
-                        //       Have option to override this in DISPLAY.
-                        if( getModelLabel( altFileName, TRIPLET( 1.0, 1.0, 1.0 ), aLabel, false ) )
-                        {
-                            return true;
-                        }
+                        return true;
                     }
                 }
 
@@ -1172,6 +1489,12 @@ bool PCBMODEL::getModelLabel( const std::string& aFileName, TRIPLET aScale, TDF_
             return false;
     }
 
+    // The same document is shared by all the scales the model is used with
+    Handle( TDocStd_Document ) doc = getModelDoc( aFileName );
+
+    if( doc.IsNull() )
+        return false;
+
     aLabel = transferModel( doc, m_doc, aScale );
 
     if( aLabel.IsNull() )
@@ -1194,6 +1517,212 @@ bool PCBMODEL::getModelLabel( const std::string& aFileName, TRIPLET aScale, TDF_
 }
 
 
+Handle( TDocStd_Document ) PCBMODEL::getModelDoc( const std::string& aFileName )
+{
+    if( m_modelDocs.find( aFileName ) == m_modelDocs.end() )
+        PreloadModels( { aFileName }, false );
+
+    MODEL_DOC_MAP::const_iterator it = m_modelDocs.find( aFileName );
+
+    if( it == m_modelDocs.end() )
+        return Handle( TDocStd_Document )();
+
+    return it->second;
+}
+
+
+void PCBMODEL::PreloadModels( const std::vector<std::string>& aFileNames,
+                              bool aSubstituteModels )
+{
+    struct MODEL_READ
+    {
+        std::string                m_fileName;  // model file
+        wxString                   m_readName;  // file actually read (decompressed STEPZ)
+        FormatType                 m_format;
+        std::string                m_cacheKey;
+        Handle( TDocStd_Document ) m_doc;
+        bool                       m_ok;
+    };
+
+    std::vector<std::string> fileNames;
+
+    for( const std::string& fileName : aFileNames )
+    {
+        wxFileName file( wxString::FromUTF8Unchecked( fileName.c_str() ) );
+        wxString   ext = file.GetExt().Lower();
+
+        // Missing files are reported when adding the components
+        if( !file.FileExists() )
+            continue;
+
+        if( ext == "wrl" || ext == "wrz" )
+        {
+            // Only the substitute getModelLabel() tries first; the others are only read, one
+            // at a time, if it fails
+            if( aSubstituteModels )
+            {
+                std::vector<std::string> substitutes = substituteModels( fileName );
+
+                if( !substitutes.empty() )
+                    fileNames.push_back( substitutes.front() );
+            }
+        }
+        else
+        {
+            fileNames.push_back( fileName );
+        }
+    }
+
+    std::set<std::string>   seen;
+    std::vector<MODEL_READ> reads;
+
+    for( const std::string& fileName : fileNames )
+    {
+        if( m_modelDocs.count( fileName ) || !seen.insert( fileName ).second )
+            continue;
+
+        MODEL_READ read;
+        read.m_fileName = fileName;
+        read.m_readName = wxString::FromUTF8Unchecked( fileName.c_str() );
+        read.m_format = fileType( fileName.c_str() );
+        read.m_ok = false;
+
+        if( read.m_format != FMT_STEP && read.m_format != FMT_STEPZ
+                && read.m_format != FMT_IGES )
+        {
+            continue;
+        }
+
+        if( !m_cacheDir.IsEmpty() )
+        {
+            read.m_cacheKey = modelHash( fileName );
+
+            if( !read.m_cacheKey.empty() && loadCachedModel( read.m_cacheKey, read.m_doc ) )
+            {
+                m_modelDocs[fileName] = read.m_doc;
+                continue;
+            }
+        }
+
+        if( read.m_format == FMT_STEPZ && !decompressModel( fileName, read.m_readName ) )
+        {
+            ReportMessage( wxString::Format( "readSTEP() failed on filename '%s'.\n",
+                                             fileName ) );
+            m_modelDocs[fileName] = Handle( TDocStd_Document )();
+            continue;
+        }
+
+        // Documents must be created by the application, which is not thread safe
+        m_app->NewDocument( "MDTV-XCAF", read.m_doc );
+        reads.push_back( read );
+    }
+
+    if( reads.empty() )
+        return;
+
+    ReportMessage( wxString::Format( "Read %d model files.\n", (int) reads.size() ) );
+
+    auto readModel =
+            [&]( MODEL_READ& aRead, bool aSerial )
+            {
+                std::string readName( aRead.m_readName.ToUTF8() );
+
+                try
+                {
+                    if( aRead.m_format == FMT_IGES )
+                        aRead.m_ok = readIGES( aRead.m_doc, readName.c_str() );
+                    else if( aSerial )
+                        aRead.m_ok = readSTEP( aRead.m_doc, readName.c_str() );
+                    else
+                        aRead.m_ok = readSTEPFile( aRead.m_doc, readName.c_str() );
+                }
+                catch( const Standard_Failure& )
+                {
+                    aRead.m_ok = false;
+                }
+            };
+
+    std::vector<MODEL_READ*> stepReads;
+
+    // The IGES translator relies on global state: these files are always read one at a time
+    for( MODEL_READ& read : reads )
+    {
+        if( read.m_format == FMT_IGES )
+            readModel( read, true );
+        else
+            stepReads.push_back( &read );
+    }
+
+#ifdef PARALLEL_STEP_READ
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   stepReads.size() );
+#else
+    size_t parallelThreadCount = 1;
+#endif
+
+    if( parallelThreadCount <= 1 )
+    {
+        for( MODEL_READ* read : stepReads )
+            readModel( *read, true );
+    }
+    else
+    {
+        // The translator parameters are global: set them once before starting the threads
+        STEPCAFControl_Controller::Init();
+        setReadPrecision();
+
+        std::atomic<size_t>            nextRead( 0 );
+        std::vector<std::future<void>> returns( parallelThreadCount );
+
+        auto read_lambda =
+                [&]()
+                {
+                    for( size_t ii = nextRead++; ii < stepReads.size(); ii = nextRead++ )
+                        readModel( *stepReads[ii], false );
+                };
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, read_lambda );
+
+        for( const std::future<void>& ret : returns )
+            ret.wait();
+    }
+
+    bool cacheUpdated = false;
+
+    for( MODEL_READ& read : reads )
+    {
+        if( read.m_format == FMT_STEPZ )
+            wxRemoveFile( read.m_readName );
+
+        if( !read.m_ok )
+        {
+            ReportMessage( wxString::Format( "%s failed on filename '%s'.\n",
+                                             read.m_format == FMT_IGES ? "readIGES()"
+                                                                       : "readSTEP()",
+                                             read.m_fileName ) );
+
+            if( !read.m_doc.IsNull() && read.m_doc->IsOpened() )
+                read.m_doc->Close();
+
+            m_modelDocs[read.m_fileName] = Handle( TDocStd_Document )();
+            continue;
+        }
+
+        if( !read.m_cacheKey.empty() )
+        {
+            saveCachedModel( read.m_cacheKey, read.m_doc );
+            cacheUpdated = true;
+        }
+
+        m_modelDocs[read.m_fileName] = read.m_doc;
+    }
+
+    if( cacheUpdated )
+        trimModelCache();
+}
+
+
 bool PCBMODEL::getModelLocation( bool aBottom, DOUBLET aPosition, double aRotation, TRIPLET aOffset,
                                  TRIPLET aOrientation, TopLoc_Location& aLocation )
 {
@@ -1259,12 +1788,7 @@ bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+    if( !setReadPrecision() )
         return false;
 
     // set other translation options
@@ -1291,39 +1815,128 @@ bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
 
 bool PCBMODEL::readSTEP( Handle(TDocStd_Document)& doc, const char* fname )
 {
-    STEPCAFControl_Reader reader;
-    IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
+    // The translator parameters only exist once the controller is initialized
+    STEPCAFControl_Controller::Init();
 
-    if( stat != IFSelect_RetDone )
+    if( !setReadPrecision() || !readSTEPFile( doc, fname ) )
+    {
+        doc->Close();
         return false;
+    }
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
+    return true;
+}
 
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+
+bool PCBMODEL::loadCachedModel( const std::string& aKey, Handle( TDocStd_Document )& aDoc )
+{
+#ifdef STEP_MODEL_CACHE
+    wxFileName cacheFile( m_cacheDir, aKey, "xbf" );
+
+    if( !cacheFile.FileExists() )
         return false;
 
-    // set other translation options
-    reader.SetColorMode(true);  // use model colors
-    reader.SetNameMode(false);  // don't use label names
-    reader.SetLayerMode(false); // ignore LAYER data
+    TCollection_ExtendedString path( cacheFile.GetFullPath().utf8_str(), Standard_True );
 
-    if ( !reader.Transfer( doc ) )
+    try
+    {
+        if( m_app->Open( path, aDoc ) == PCDM_RS_OK && !aDoc.IsNull() )
+        {
+            // Keep the entries in use from being trimmed first
+            cacheFile.Touch();
+            return true;
+        }
+    }
+    catch( const Standard_Failure& )
     {
-        doc->Close();
-        return false;
     }
 
-    // are there any shapes to translate?
-    if( reader.NbRootsForTransfer() < 1 )
+    // A stale or truncated cache entry is simply rebuilt
+    ReportMessage( wxString::Format( "Could not read cached model '%s'.\n",
+                                     cacheFile.GetFullPath() ) );
+    aDoc.Nullify();
+#endif
+
+    return false;
+}
+
+
+void PCBMODEL::saveCachedModel( const std::string& aKey, Handle( TDocStd_Document )& aDoc )
+{
+#ifdef STEP_MODEL_CACHE
+    if( !wxFileName::DirExists( m_cacheDir )
+            && !wxFileName::Mkdir( m_cacheDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
     {
-        doc->Close();
-        return false;
+        return;
     }
 
-    return true;
+    wxFileName                 cacheFile( m_cacheDir, aKey, "xbf" );
+    TCollection_ExtendedString path( cacheFile.GetFullPath().utf8_str(), Standard_True );
+
+    try
+    {
+        aDoc->ChangeStorageFormat( "BinXCAF" );
+
+        if( m_app->SaveAs( aDoc, path ) != PCDM_SS_OK )
+            wxRemoveFile( cacheFile.GetFullPath() );
+    }
+    catch( const Standard_Failure& )
+    {
+        wxRemoveFile( cacheFile.GetFullPath() );
+    }
+#endif
+}
+
+
+void PCBMODEL::trimModelCache()
+{
+#ifdef STEP_MODEL_CACHE
+    wxDir dir( m_cacheDir );
+
+    if( !dir.IsOpened() )
+        return;
+
+    struct CACHE_ENTRY
+    {
+        wxString    m_path;
+        time_t      m_time;
+        wxULongLong m_size;
+    };
+
+    std::vector<CACHE_ENTRY> entries;
+    wxULongLong              totalSize = 0;
+    wxString                 name;
+
+    for( bool cont = dir.GetFirst( &name, "*.xbf", wxDIR_FILES ); cont; cont = dir.GetNext( &name ) )
+    {
+        wxFileName  file( m_cacheDir, name );
+        wxULongLong size = file.GetSize();
+
+        if( size == wxInvalidSize )
+            continue;
+
+        entries.push_back( { file.GetFullPath(), file.GetModificationTime().GetTicks(), size } );
+        totalSize += size;
+    }
+
+    if( totalSize.GetValue() <= MODEL_CACHE_MAX_SIZE )
+        return;
+
+    std::sort( entries.begin(), entries.end(),
+               []( const CACHE_ENTRY& aLeft, const CACHE_ENTRY& aRight )
+               {
+                   return aLeft.m_time < aRight.m_time;
+               } );
+
+    for( const CACHE_ENTRY& entry : entries )
+    {
+        if( totalSize.GetValue() <= MODEL_CACHE_MAX_SIZE )
+            break;
+
+        if( wxRemoveFile( entry.m_path ) )
+            totalSize -= entry.m_size;
+    }
+#endif
 }
 
 
@@ -27,13 +27,17 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include "base.h"
 #include "kicadpcb.h"
 #include "kicadcurve.h"
 
+#include <wx/string.h>
+
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <TDocStd_Document.hxx>
 #include <XCAFApp_Application.hxx>
@@ -44,6 +48,7 @@
 
 typedef std::pair< std::string, TDF_Label > MODEL_DATUM;
 typedef std::map< std::string, TDF_Label > MODEL_MAP;
+typedef std::map< std::string, Handle( TDocStd_Document ) > MODEL_DOC_MAP;
 
 class KICADPAD;
 
@@ -89,6 +94,9 @@ class PCBMODEL
     bool                            m_hasPCB;       // set true if CreatePCB() has been invoked
     TDF_Label                       m_pcb_label;    // label for the PCB model
     MODEL_MAP                       m_models;       // map of file names to model labels
+    MODEL_DOC_MAP                   m_modelDocs;    // map of file names to the documents read
+                                                    // from them (null if the read failed)
+    wxString                        m_cacheDir;     // translated model cache, empty if disabled
     int                             m_components;   // number of successfully loaded components;
     double                          m_precision;    // model (length unit) numeric precision
     double                          m_angleprec;    // angle numeric precision
@@ -99,6 +107,8 @@ class PCBMODEL
 
     std::list<KICADCURVE>           m_curves;
     std::vector<TopoDS_Shape>       m_cutouts;
+    std::set<std::tuple<double, double, double>> m_roundHoles; // position and diameter of the
+                                                               // round holes in m_cutouts
 
     /**
      * Load a 3D model data
@@ -116,12 +126,37 @@ class PCBMODEL
     bool getModelLocation( bool aBottom, DOUBLET aPosition, double aRotation,
         TRIPLET aOffset, TRIPLET aOrientation, TopLoc_Location& aLocation );
 
+    /**
+     * Return the document read from a STEP or IGES model file, reading it if it was not
+     * preloaded.
+     *
+     * @return a null handle if the file could not be read.
+     */
+    Handle( TDocStd_Document ) getModelDoc( const std::string& aFileName );
+
     bool readIGES( Handle( TDocStd_Document )& m_doc, const char* fname );
     bool readSTEP( Handle( TDocStd_Document )& m_doc, const char* fname );
 
+    // translated model cache, keyed by a hash of the model file contents
+    bool loadCachedModel( const std::string& aKey, Handle( TDocStd_Document )& aDoc );
+    void saveCachedModel( const std::string& aKey, Handle( TDocStd_Document )& aDoc );
+
+    // remove the least recently used cache entries until the cache fits MODEL_CACHE_MAX_SIZE
+    void trimModelCache();
+
     TDF_Label transferModel( Handle( TDocStd_Document )& source,
                              Handle( TDocStd_Document )& dest, TRIPLET aScale );
 
+    /**
+     * Subtract m_cutouts from the board body.
+     *
+     * Boards with many holes are split in tiles which are cut in parallel and fused back,
+     * since a single boolean operation with thousands of tools is very slow.
+     *
+     * @return false if the boolean operations failed.
+     */
+    bool cutBoardHoles( TopoDS_Shape& aBoard );
+
 public:
     PCBMODEL();
     virtual ~PCBMODEL();
@@ -132,6 +167,25 @@ public:
     // add a pad hole or slot (must be in final position)
     bool AddPadHole( const KICADPAD* aPad );
 
+    /**
+     * Read the given model files ahead of AddComponent().
+     *
+     * Each file is read once, whatever the number of components using it.  Files found in the
+     * translated model cache are not parsed at all, and STEP files are parsed in parallel when
+     * the OpenCascade version allows it.
+     *
+     * @param aFileNames is the list of model files, which may contain duplicates.
+     * @param aSubstituteModels = true to also read the preferred STEP/IGES substitute of VRML
+     *                          files.
+     */
+    void PreloadModels( const std::vector<std::string>& aFileNames, bool aSubstituteModels );
+
+    // set the directory of the translated model cache; an empty path disables the cache
+    void SetModelCacheDir( const wxString& aDir )
+    {
+        m_cacheDir = aDir;
+    }
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes,
         bool aBottom, DOUBLET aPosition, double aRotation,